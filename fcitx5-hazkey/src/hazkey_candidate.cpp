@@ -9,6 +9,11 @@ namespace fcitx {
 /// CandidateWord
 
 std::vector<std::string> HazkeyCandidateWord::getPreedit() const {
+    if (reading_) {
+        // the unconverted rest is only cut out when it is shown
+        if (consumedBytes_ >= reading_->size()) return {candidate_};
+        return {candidate_, reading_->substr(consumedBytes_)};
+    }
     if (hiragana_.empty()) return {candidate_};
     return {candidate_, hiragana_};
 }
@@ -26,14 +31,16 @@ void HazkeyCandidateWord::select(InputContext* ic) const {
 /// CandidateList
 
 HazkeyCandidateList::HazkeyCandidateList(
-    const google::protobuf::RepeatedPtrField<
-        ::hazkey::commands::CandidatesResult_Candidate>
-        candidates)
+    const hazkey::commands::CandidatesResult& result)
     : CommonCandidateList() {
+    std::shared_ptr<const std::string> reading;
+    if (!result.reading().empty()) {
+        reading = std::make_shared<const std::string>(result.reading());
+    }
     // CandidateWord needs to know their own index
     int i = 0;
-    for (const auto& candidate : candidates) {
-        append(std::make_unique<HazkeyCandidateWord>(i, candidate));
+    for (const auto& candidate : result.candidates()) {
+        append(std::make_unique<HazkeyCandidateWord>(i, candidate, reading));
         i++;
     }
 }
@@ -5,6 +5,8 @@
 #include <fcitx/inputcontext.h>
 #include <fcitx/text.h>
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -22,12 +24,18 @@ const KeyList defaultSelectionKeys = {
 
 class HazkeyCandidateWord : public CandidateWord {
    public:
-    HazkeyCandidateWord(const int index,
-                        const hazkey::commands::CandidatesResult_Candidate data)
+    // `reading` is shared by the candidates of a compact result and null
+    // otherwise; see CandidatesResult in commands.proto.
+    HazkeyCandidateWord(
+        const int index,
+        const hazkey::commands::CandidatesResult_Candidate& data,
+        std::shared_ptr<const std::string> reading)
         : CandidateWord(Text(data.text())),
           index_(index),
-          candidate_(std::move(data.text())),
-          hiragana_(std::move(data.sub_hiragana())) {
+          candidate_(data.text()),
+          hiragana_(data.sub_hiragana()),
+          reading_(std::move(reading)),
+          consumedBytes_(std::max(0, data.consumed_bytes())) {
         setText(Text(data.text()));
     }
 
@@ -44,6 +52,8 @@ class HazkeyCandidateWord : public CandidateWord {
     const int index_;
     const std::string candidate_;
     const std::string hiragana_;
+    const std::shared_ptr<const std::string> reading_;
+    const size_t consumedBytes_;
     // const int corresponding_count_;
     // const std::vector<std::string> parts_;
     // const std::vector<int> part_lens_;
@@ -51,9 +61,8 @@ class HazkeyCandidateWord : public CandidateWord {
 
 class HazkeyCandidateList : public CommonCandidateList {
    public:
-    HazkeyCandidateList(google::protobuf::RepeatedPtrField<
-                        hazkey::commands::CandidatesResult_Candidate>
-                            candidates);
+    explicit HazkeyCandidateList(
+        const hazkey::commands::CandidatesResult& result);
 
     // return the direction of the candidate list
     // currently always vertical
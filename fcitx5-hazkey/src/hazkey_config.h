@@ -19,6 +19,14 @@ FCITX_CONFIGURATION(HazkeyEngineConfig,
                     Option<bool> showTabToSelect{
                         this, "showTabToSelect",
                         _("Show [Press Tab to Select] indicator"), true};
+                    Option<int, IntConstrain> contextWindowLength{
+                        this, "contextWindowLength",
+                        _("Characters before the cursor sent as context"), 40,
+                        IntConstrain(0, 1000)};
+                    Option<bool> inProcessConverter{
+                        this, "inProcessConverter",
+                        _("Run the converter inside fcitx5 (experimental)"),
+                        false};
                     ExternalOption openHazkeySettings{
                         this, "openHazkeySettings", _("Open Hazkey Settings"),
                         stringutils::concat("hazkey-settings")};);
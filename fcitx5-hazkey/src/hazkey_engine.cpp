@@ -5,15 +5,25 @@
 #include "hazkey_server_connector.h"
 #include "hazkey_state.h"
 #include "hazkey_constants.h"
+#include "hazkey_trace.h"
 
 namespace fcitx {
 
-HazkeyEngine::HazkeyEngine(Instance *instance)
-    : instance_(instance), factory_([this](InputContext &ic) {
-          return new HazkeyState(this, &ic);
-      }) {
-    server_ = HazkeyServerConnector();
+namespace {
+
+// The connector is created before reloadConfig(), so read the option that
+// decides whether hazkey-server is started at all here.
+bool readInProcessOption(HazkeyEngineConfig &config) {
+    readAsIni(config, "conf/hazkey.conf");
+    return *config.inProcessConverter;
+}
 
+}  // namespace
+
+HazkeyEngine::HazkeyEngine(Instance *instance)
+    : instance_(instance),
+      factory_([this](InputContext &ic) { return new HazkeyState(this, &ic); }),
+      server_(readInProcessOption(config_)) {
     instance->inputContextManager().registerProperty("hazkeyState", &factory_);
     reloadConfig();
 }
@@ -22,6 +32,13 @@ void HazkeyEngine::keyEvent([[maybe_unused]] const InputMethodEntry &entry,
                             KeyEvent &keyEvent) {
     FCITX_DEBUG() << "keyEvent: " << keyEvent.key().toString();
 
+    // every request sent for this key carries the same trace ID
+    TraceScope traceScope;
+    TraceSpan traceSpan("fcitx", "keyEvent", traceScope.id());
+    if (traceSpan.active()) {
+        traceSpan.setDetail(keyEvent.key().toString());
+    }
+
     auto inputContext = keyEvent.inputContext();
     inputContext->propertyFor(&factory_)->keyEvent(keyEvent);
     inputContext->updatePreedit();
@@ -59,12 +76,22 @@ void HazkeyEngine::setConfig(const RawConfig &config) {
 void HazkeyEngine::reloadConfig() {
     readAsIni(config_, "conf/hazkey.conf");
 
+    // The core serves the hazkey-server socket while it is loaded, so
+    // hazkey-settings reaches whichever converter is in use.
+    if (!server_.setInProcess(*config_.inProcessConverter)) {
+        FCITX_WARN() << "In-process converter unavailable, using hazkey-server";
+    }
+
     std::string lastVersion = config_.lastVersion.value();
 
     if (lastVersion != HAZKEY_VERSION) {
-        FCITX_DEBUG() << "Update detected. restarting server..";
-        // server automatically restarts if current server is newer than running server.
-        server_.startHazkeyServer(false);
+        // A running server that speaks a supported protocol keeps serving
+        // with its dictionary and Zenzai model loaded, whatever its release;
+        // features it lacks are left unused. Any other one is replaced.
+        if (!server_.isInProcess() && !server_.serverProtocolSupported()) {
+            FCITX_DEBUG() << "Update detected. restarting server..";
+            server_.startHazkeyServer(true);
+        }
 
         config_.lastVersion.setValue(HAZKEY_VERSION);
         safeSaveAsIni(config_, "conf/hazkey.conf");
@@ -0,0 +1,76 @@
+#include "hazkey_inprocess_core.h"
+
+#include <fcitx-utils/log.h>
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "hazkey_constants.h"
+
+std::shared_ptr<HazkeyInProcessCore> HazkeyInProcessCore::load() {
+    const char* envPath = std::getenv("HAZKEY_CORE_LIBRARY");
+    std::string path =
+        envPath && envPath[0] != '\0' ? envPath : HAZKEY_CORE_LIBRARY;
+
+    std::shared_ptr<HazkeyInProcessCore> core(new HazkeyInProcessCore(path));
+    // the Swift runtime cannot be unloaded safely
+    if (!core->library_.load(fcitx::LibraryLoadHint::PreventUnloadHint)) {
+        FCITX_ERROR() << "Failed to load " << path << ": "
+                      << core->library_.error();
+        return nullptr;
+    }
+
+    auto create = reinterpret_cast<CreateFunc>(
+        core->library_.resolve("hazkey_core_create"));
+    core->transact_ = reinterpret_cast<TransactFunc>(
+        core->library_.resolve("hazkey_core_transact"));
+    core->free_ =
+        reinterpret_cast<FreeFunc>(core->library_.resolve("hazkey_core_free"));
+    core->destroy_ = reinterpret_cast<DestroyFunc>(
+        core->library_.resolve("hazkey_core_destroy"));
+    if (!create || !core->transact_ || !core->free_ || !core->destroy_) {
+        FCITX_ERROR() << path << " is not a hazkey core library";
+        return nullptr;
+    }
+
+    core->core_ = create();
+    FCITX_INFO() << "Loaded in-process hazkey core from " << path;
+    return core;
+}
+
+HazkeyInProcessCore::HazkeyInProcessCore(std::string path)
+    : library_(std::move(path)) {}
+
+HazkeyInProcessCore::~HazkeyInProcessCore() {
+    if (core_) {
+        // saves pending learning data
+        destroy_(core_);
+    }
+}
+
+std::optional<hazkey::ResponseEnvelope> HazkeyInProcessCore::transact(
+    const hazkey::RequestEnvelope& request) {
+    std::string msg;
+    if (!request.SerializeToString(&msg)) {
+        FCITX_ERROR() << "Failed to serialize protobuf message.";
+        return std::nullopt;
+    }
+
+    uint8_t* responseData = nullptr;
+    size_t responseSize = 0;
+    if (transact_(core_, reinterpret_cast<const uint8_t*>(msg.data()),
+                  msg.size(), &responseData, &responseSize) != 0) {
+        FCITX_ERROR() << "In-process hazkey core failed to handle the request";
+        return std::nullopt;
+    }
+
+    hazkey::ResponseEnvelope response;
+    bool parsed = response.ParseFromArray(responseData, responseSize);
+    free_(responseData);
+    if (!parsed) {
+        FCITX_ERROR() << "Failed to parse response from hazkey core.";
+        return std::nullopt;
+    }
+    return response;
+}
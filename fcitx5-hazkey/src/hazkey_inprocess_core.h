@@ -0,0 +1,50 @@
+#ifndef _FCITX5_HAZKEY_HAZKEY_INPROCESS_CORE_H_
+#define _FCITX5_HAZKEY_HAZKEY_INPROCESS_CORE_H_
+
+#include <fcitx-utils/library.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "base.pb.h"
+
+// Converter core of hazkey-server loaded into the addon (libhazkey-core.so).
+// It takes the same envelopes as the socket, so HazkeyServerConnector only
+// swaps the transport. See inProcessCore.swift for the C ABI.
+//
+// The core assumes it is the only converter of the user: it writes the
+// learning data (memory directory and journal) without coordinating with
+// another process. It therefore stops a running hazkey-server and serves the
+// hazkey-server socket itself until it is destroyed, so hazkey-settings talks
+// to this converter.
+class HazkeyInProcessCore {
+   public:
+    // Loads the library from HAZKEY_CORE_LIBRARY (environment variable, or
+    // the installed path) and creates the core. nullptr on failure.
+    static std::shared_ptr<HazkeyInProcessCore> load();
+
+    ~HazkeyInProcessCore();
+
+    std::optional<hazkey::ResponseEnvelope> transact(
+        const hazkey::RequestEnvelope& request);
+
+   private:
+    using CreateFunc = void* (*)();
+    using TransactFunc = int (*)(void*, const uint8_t*, size_t, uint8_t**,
+                                 size_t*);
+    using FreeFunc = void (*)(uint8_t*);
+    using DestroyFunc = void (*)(void*);
+
+    explicit HazkeyInProcessCore(std::string path);
+
+    fcitx::Library library_;
+    void* core_ = nullptr;
+    TransactFunc transact_ = nullptr;
+    FreeFunc free_ = nullptr;
+    DestroyFunc destroy_ = nullptr;
+};
+
+#endif  // _FCITX5_HAZKEY_HAZKEY_INPROCESS_CORE_H_
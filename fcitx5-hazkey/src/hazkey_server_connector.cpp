@@ -4,6 +4,7 @@
 #include <dirent.h>
 #include <fcitx-utils/log.h>
 #include <fcitx-utils/textformatflags.h>
+#include <fcitx-utils/utf8.h>
 #include <fcitx/text.h>
 #include <fcntl.h>
 #include <signal.h>
@@ -24,18 +25,14 @@
 
 #include "base.pb.h"
 #include "commands.pb.h"
+#include "hazkey_constants.h"
+#include "hazkey_socket_path.h"
+#include "hazkey_trace.h"
 
 static std::mutex transact_mutex;
 
 std::string HazkeyServerConnector::getSocketPath() {
-    const char* xdg_runtime_dir = std::getenv("XDG_RUNTIME_DIR");
-    uid_t uid = getuid();
-    std::string sockname = "hazkey-server." + std::to_string(uid) + ".sock";
-    if (xdg_runtime_dir && xdg_runtime_dir[0] != '\0') {
-        return std::string(xdg_runtime_dir) + "/" + sockname;
-    } else {
-        return "/tmp/" + sockname;
-    }
+    return hazkeySocketPath();
 }
 
 void HazkeyServerConnector::startHazkeyServer(bool force_restart) {
@@ -99,6 +96,8 @@ bool readAll(int fd, void* data, size_t len) {
 
 void HazkeyServerConnector::connectServer() {
     std::string socket_path = getSocketPath();
+    // a (re)started server does not know the previous context
+    lastContextHash_.reset();
 
     // try restarting server only 1 time
     // on 1st attempt (minus 1)
@@ -136,6 +135,7 @@ void HazkeyServerConnector::connectServer() {
         int ret = connect(sock_, (sockaddr*)&addr, sizeof(addr));
         if (ret == 0) {
             // Connected
+            negotiate();
             return;
         }
         if (errno == EINPROGRESS) {
@@ -150,6 +150,7 @@ void HazkeyServerConnector::connectServer() {
                 getsockopt(sock_, SOL_SOCKET, SO_ERROR, &so_error, &len);
                 if (so_error == 0) {
                     // Connected
+                    negotiate();
                     return;
                 }
             }
@@ -170,9 +171,227 @@ void HazkeyServerConnector::connectServer() {
                  << " attempts";
 }
 
+// A server that predates Hello answers with an error; it is treated as
+// protocol version 0 without optional features.
+void HazkeyServerConnector::negotiate() {
+    hazkey::RequestEnvelope request;
+    auto hello = request.mutable_hello();
+    hello->set_protocol_version(HAZKEY_PROTOCOL_VERSION);
+    hello->set_features(kClientFeatures);
+    hello->set_version(HAZKEY_VERSION);
+
+    // a new server or core has its own composition
+    composingVariants_.reset();
+
+    auto response = inProcessCore_ ? inProcessCore_->transact(request)
+                                   : exchangeOnSocket(request);
+    if (!response) {
+        serverHello_.reset();
+        return;
+    }
+    if (response->status() != hazkey::SUCCESS ||
+        !response->has_hello_result()) {
+        FCITX_INFO() << "hazkey-server does not support Hello, optional "
+                        "features are disabled";
+        serverHello_ = hazkey::commands::HelloResult();
+        return;
+    }
+    serverHello_ = response->hello_result();
+    serverHello_->set_features(serverHello_->features() & kClientFeatures);
+    FCITX_DEBUG() << "hazkey-server " << serverHello_->version()
+                  << ", protocol " << serverHello_->protocol_version()
+                  << ", features " << serverHello_->features();
+}
+
+std::optional<hazkey::ResponseEnvelope> HazkeyServerConnector::exchangeOnSocket(
+    const hazkey::RequestEnvelope& request) {
+    std::string msg;
+    if (sock_ == -1 || !request.SerializeToString(&msg)) {
+        return std::nullopt;
+    }
+    uint32_t writeLen = htonl(msg.size());
+    uint32_t readLenBuf;
+    if (!writeAll(sock_, &writeLen, 4) ||
+        !writeAll(sock_, msg.c_str(), msg.size()) ||
+        !readAll(sock_, &readLenBuf, 4)) {
+        FCITX_ERROR() << "Failed to exchange "
+                      << commandName(request.payload_case())
+                      << " with hazkey-server";
+        close(sock_);
+        sock_ = -1;
+        return std::nullopt;
+    }
+    uint32_t readLen = ntohl(readLenBuf);
+    std::vector<char> buf(readLen);
+    hazkey::ResponseEnvelope resp;
+    if (readLen > 2 * 1024 * 1024 || !readAll(sock_, buf.data(), readLen) ||
+        !resp.ParseFromArray(buf.data(), readLen)) {
+        FCITX_ERROR() << "Invalid " << commandName(request.payload_case())
+                      << " response from hazkey-server";
+        close(sock_);
+        sock_ = -1;
+        return std::nullopt;
+    }
+    return resp;
+}
+
+void HazkeyServerConnector::openSessionLog() {
+    const char* path = std::getenv("HAZKEY_RECORD_SESSION");
+    if (!path || path[0] == '\0') {
+        return;
+    }
+    sessionLog_ = SessionLogWriter::open(path);
+    if (sessionLog_) {
+        FCITX_INFO() << "Recording hazkey session to " << path;
+    } else {
+        FCITX_ERROR() << "Failed to open session log: " << path;
+    }
+}
+
+bool HazkeyServerConnector::setInProcess(bool inProcess) {
+    std::lock_guard<std::mutex> lock(transact_mutex);
+    if (inProcess == (inProcessCore_ != nullptr)) {
+        return true;
+    }
+    if (!inProcess) {
+        inProcessCore_.reset();
+        connectServer();
+        return true;
+    }
+    inProcessCore_ = HazkeyInProcessCore::load();
+    if (!inProcessCore_) {
+        // transact() connects to the server when needed
+        return false;
+    }
+    if (sock_ != -1) {
+        close(sock_);
+        sock_ = -1;
+    }
+    lastContextHash_.reset();
+    negotiate();
+    return true;
+}
+
+const char* HazkeyServerConnector::commandName(
+    hazkey::RequestEnvelope::PayloadCase command) {
+    switch (command) {
+        case hazkey::RequestEnvelope::kHello:
+            return "hello";
+        case hazkey::RequestEnvelope::kNewComposingText:
+            return "new_composing_text";
+        case hazkey::RequestEnvelope::kSetContext:
+            return "set_context";
+        case hazkey::RequestEnvelope::kInputChar:
+            return "input_char";
+        case hazkey::RequestEnvelope::kModifierEvent:
+            return "modifier_event";
+        case hazkey::RequestEnvelope::kMoveCursor:
+            return "move_cursor";
+        case hazkey::RequestEnvelope::kPrefixComplete:
+            return "prefix_complete";
+        case hazkey::RequestEnvelope::kDeleteLeft:
+            return "delete_left";
+        case hazkey::RequestEnvelope::kDeleteRight:
+            return "delete_right";
+        case hazkey::RequestEnvelope::kGetComposingString:
+            return "get_composing_string";
+        case hazkey::RequestEnvelope::kGetComposingVariants:
+            return "get_composing_variants";
+        case hazkey::RequestEnvelope::kGetHiraganaWithCursor:
+            return "get_hiragana_with_cursor";
+        case hazkey::RequestEnvelope::kGetCandidates:
+            return "get_candidates";
+        case hazkey::RequestEnvelope::kGetLiveText:
+            return "get_live_text";
+        case hazkey::RequestEnvelope::kGetCurrentInputMode:
+            return "get_current_input_mode";
+        case hazkey::RequestEnvelope::kSaveLearningData:
+            return "save_learning_data";
+        case hazkey::RequestEnvelope::kGetServerStatus:
+            return "get_server_status";
+        case hazkey::RequestEnvelope::kGetStats:
+            return "get_stats";
+        case hazkey::RequestEnvelope::kConvertBatch:
+            return "convert_batch";
+        case hazkey::RequestEnvelope::kRunBenchmark:
+            return "run_benchmark";
+        case hazkey::RequestEnvelope::kGetConfig:
+            return "get_config";
+        case hazkey::RequestEnvelope::kSetConfig:
+            return "set_config";
+        case hazkey::RequestEnvelope::kGetDefaultProfile:
+            return "get_default_profile";
+        case hazkey::RequestEnvelope::kClearAllHistory:
+            return "clear_all_history";
+        case hazkey::RequestEnvelope::kReloadZenzaiModel:
+            return "reload_zenzai_model";
+        case hazkey::RequestEnvelope::PAYLOAD_NOT_SET:
+            break;
+    }
+    return "none";
+}
+
+bool HazkeyServerConnector::keepsComposition(
+    hazkey::RequestEnvelope::PayloadCase command) {
+    switch (command) {
+        case hazkey::RequestEnvelope::kGetComposingString:
+        case hazkey::RequestEnvelope::kGetComposingVariants:
+        case hazkey::RequestEnvelope::kGetHiraganaWithCursor:
+        case hazkey::RequestEnvelope::kGetCandidates:
+        case hazkey::RequestEnvelope::kGetLiveText:
+        case hazkey::RequestEnvelope::kGetCurrentInputMode:
+        case hazkey::RequestEnvelope::kGetServerStatus:
+        case hazkey::RequestEnvelope::kGetStats:
+            return true;
+        default:
+            return false;
+    }
+}
+
 std::optional<hazkey::ResponseEnvelope> HazkeyServerConnector::transact(
+    const hazkey::RequestEnvelope& send_data) {
+    if (!pendingDirectInput_.empty()) {
+        if (send_data.payload_case() ==
+            hazkey::RequestEnvelope::kNewComposingText) {
+            pendingDirectInput_.clear();
+        } else {
+            flushDirectInput();
+        }
+    }
+    if (!keepsComposition(send_data.payload_case())) {
+        composingVariants_.reset();
+    }
+
+    const hazkey::RequestEnvelope* request = &send_data;
+    hazkey::RequestEnvelope traced;
+    std::optional<TraceSpan> traceSpan;
+    auto& trace = HazkeyTrace::instance();
+    if (trace.enabled()) {
+        traced = send_data;
+        traced.set_trace_id(trace.currentTraceId());
+        request = &traced;
+        traceSpan.emplace("transact", commandName(send_data.payload_case()),
+                          traced.trace_id());
+    }
+
+    if (!sessionLog_) {
+        return sendAndReceive(*request);
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto response = sendAndReceive(*request);
+    sessionLog_->write(*request, response, start,
+                       std::chrono::steady_clock::now());
+    return response;
+}
+
+std::optional<hazkey::ResponseEnvelope> HazkeyServerConnector::sendAndReceive(
     const hazkey::RequestEnvelope& send_data) {
     std::lock_guard<std::mutex> lock(transact_mutex);
+    ++transactCount_;
+
+    if (inProcessCore_) {
+        return inProcessCore_->transact(send_data);
+    }
 
     if (sock_ == -1) {
         FCITX_INFO() << "Socket not connected, attempting to connect...";
@@ -279,6 +498,32 @@ std::string HazkeyServerConnector::getComposingText(
     return responseVal.text();
 }
 
+std::optional<hazkey::commands::ComposingVariants>
+HazkeyServerConnector::getComposingVariants() {
+    if (composingVariants_) {
+        return composingVariants_;
+    }
+    if (!serverSupports(hazkey::commands::Hello::FEATURE_COMPOSING_VARIANTS)) {
+        return std::nullopt;
+    }
+    hazkey::RequestEnvelope request;
+    request.mutable_get_composing_variants();
+    auto response = transact(request);
+    if (response == std::nullopt) {
+        FCITX_ERROR() << "Error while transacting getComposingVariants().";
+        return std::nullopt;
+    }
+    if (response->status() != hazkey::SUCCESS ||
+        !response->has_composing_variants()) {
+        FCITX_ERROR() << "getComposingVariants: "
+                      << "Server returned an error: "
+                      << response->error_message();
+        return std::nullopt;
+    }
+    composingVariants_ = response->composing_variants();
+    return composingVariants_;
+}
+
 fcitx::Text HazkeyServerConnector::getComposingHiraganaWithCursor() {
     hazkey::RequestEnvelope request;
     request.mutable_get_hiragana_with_cursor();
@@ -308,25 +553,72 @@ fcitx::Text HazkeyServerConnector::getComposingHiraganaWithCursor() {
     return text;
 }
 
-void HazkeyServerConnector::inputChar(std::string text) {
+bool HazkeyServerConnector::inputChar(std::string text, bool mayDefer) {
+    if (serverSupports(hazkey::commands::Hello::FEATURE_CLIENT_SUB_INPUT)) {
+        // the rules of HazkeyServerState.inputChar
+        std::string first =
+            text.substr(0, fcitx::utf8::ncharByteLength(text.begin(), 1));
+        subInputMode_ =
+            subInputMode_ ||
+            (shiftPressedAlone_ && !first.empty() &&
+             serverHello_->submode_entry_point_chars().find(first) !=
+                 std::string::npos);
+        shiftPressedAlone_ = false;
+        if (subInputMode_) {
+            pendingDirectInput_ += first;
+            composingVariants_.reset();
+            if (mayDefer) {
+                return true;
+            }
+            flushDirectInput();
+            return false;
+        }
+    }
+
     hazkey::RequestEnvelope request;
     auto props = request.mutable_input_char();
     props->set_text(text);
     auto response = transact(request);
     if (response == std::nullopt) {
         FCITX_ERROR() << "Error while transacting inputChar().";
-        return;
+        return false;
     }
     auto responseVal = response.value();
     if (responseVal.status() != hazkey::SUCCESS) {
         FCITX_ERROR() << "inputChar: " << "Server returned an error: "
                       << responseVal.error_message();
+    }
+    return false;
+}
+
+void HazkeyServerConnector::flushDirectInput() {
+    hazkey::RequestEnvelope request;
+    auto props = request.mutable_input_char();
+    props->set_text(pendingDirectInput_);
+    props->set_direct(true);
+    pendingDirectInput_.clear();
+    auto response = transact(request);
+    if (response == std::nullopt) {
+        FCITX_ERROR() << "Error while transacting flushDirectInput().";
         return;
     }
-    return;
+    if (response->status() != hazkey::SUCCESS) {
+        FCITX_ERROR() << "flushDirectInput: " << "Server returned an error: "
+                      << response->error_message();
+    }
 }
 
 void HazkeyServerConnector::shiftKeyEvent(bool isRelease) {
+    if (serverSupports(hazkey::commands::Hello::FEATURE_CLIENT_SUB_INPUT)) {
+        // the rules of HazkeyServerState.processModifierEvent
+        if (!isRelease) {
+            shiftPressedAlone_ = true;
+        } else if (shiftPressedAlone_) {
+            subInputMode_ = !subInputMode_;
+            shiftPressedAlone_ = false;
+        }
+        return;
+    }
     hazkey::RequestEnvelope request;
     auto props = request.mutable_modifier_event();
     props->set_event_type(
@@ -348,6 +640,9 @@ void HazkeyServerConnector::shiftKeyEvent(bool isRelease) {
 }
 
 bool HazkeyServerConnector::currentInputModeIsDirect() {
+    if (serverSupports(hazkey::commands::Hello::FEATURE_CLIENT_SUB_INPUT)) {
+        return subInputMode_;
+    }
     hazkey::RequestEnvelope request;
     auto _ = request.mutable_get_current_input_mode();
     auto response = transact(request);
@@ -419,11 +714,21 @@ void HazkeyServerConnector::moveCursor(int offset) {
     return;
 }
 
-void HazkeyServerConnector::setContext(std::string context, int anchor) {
+void HazkeyServerConnector::setContext(std::string context, int anchor,
+                                       int windowLength) {
+    size_t contextHash = std::hash<std::string>{}(context) ^
+                         (std::hash<int>{}(anchor) << 1) ^
+                         (std::hash<int>{}(windowLength) << 2);
+    if (lastContextHash_ == contextHash) {
+        return;
+    }
+    lastContextHash_.reset();
+
     hazkey::RequestEnvelope request;
     auto props = request.mutable_set_context();
     props->set_context(context);
     props->set_anchor(anchor);
+    props->set_window_length(windowLength);
     auto response = transact(request);
     if (response == std::nullopt) {
         FCITX_ERROR() << "Error while transacting setContext().";
@@ -435,10 +740,14 @@ void HazkeyServerConnector::setContext(std::string context, int anchor) {
                       << responseVal.error_message();
         return;
     }
+    lastContextHash_ = contextHash;
     return;
 }
 
 void HazkeyServerConnector::newComposingText() {
+    // as HazkeyServerState.createComposingTextInstanse does
+    subInputMode_ = false;
+    shiftPressedAlone_ = false;
     hazkey::RequestEnvelope request;
     request.mutable_new_composing_text();
     auto response = transact(request);
@@ -520,3 +829,52 @@ hazkey::commands::CandidatesResult HazkeyServerConnector::getCandidates(
     // }
     return responseVal.candidates();
 }
+
+hazkey::commands::CandidatesResult HazkeyServerConnector::getLiveText() {
+    hazkey::commands::CandidatesResult empty;
+    empty.set_live_text_index(-1);
+
+    hazkey::RequestEnvelope request;
+    request.mutable_get_live_text();
+    auto response = transact(request);
+    if (response == std::nullopt) {
+        FCITX_ERROR() << "Error while transacting getLiveText().";
+        return empty;
+    }
+    if (response->status() != hazkey::SUCCESS) {
+        FCITX_ERROR() << "getLiveText: " << "Server returned an error: "
+                      << response->error_message();
+        return empty;
+    }
+    return response->candidates();
+}
+
+std::optional<hazkey::commands::BatchResult>
+HazkeyServerConnector::convertBatch(
+    const hazkey::commands::ConvertBatch& batch) {
+    if (serverHello_ &&
+        !serverSupports(hazkey::commands::Hello::FEATURE_BATCH)) {
+        FCITX_ERROR() << "convertBatch: hazkey-server "
+                      << serverHello_->version()
+                      << " does not support batch conversion";
+        return std::nullopt;
+    }
+    hazkey::RequestEnvelope request;
+    *request.mutable_convert_batch() = batch;
+    auto response = transact(request);
+    if (response == std::nullopt) {
+        FCITX_ERROR() << "Error while transacting convertBatch().";
+        return std::nullopt;
+    }
+    if (response->status() != hazkey::SUCCESS) {
+        FCITX_ERROR() << "convertBatch: " << "Server returned an error: "
+                      << response->error_message();
+        return std::nullopt;
+    }
+    if (!response->has_batch_result()) {
+        FCITX_ERROR() << "convertBatch: "
+                      << "Server returned unexpected response";
+        return std::nullopt;
+    }
+    return response->batch_result();
+}
@@ -6,26 +6,66 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 
 #include "base.pb.h"
 #include "commands.pb.h"
+#include "hazkey_constants.h"
+#include "hazkey_inprocess_core.h"
+#include "hazkey_session_log.h"
 
 class HazkeyServerConnector {
    public:
     // HazkeyServerConnector();
     // ~HazkeyServerConnector();
 
-    HazkeyServerConnector() {
+    // With inProcess, the converter is loaded into this process instead of
+    // connecting to hazkey-server, falling back to the server on failure.
+    explicit HazkeyServerConnector(bool inProcess = false) {
         // kill_existing_hazkey_server();
-        connectServer();
+        openSessionLog();
+        if (!inProcess || !setInProcess(true)) {
+            connectServer();
+        }
         FCITX_DEBUG() << "Connector initialized";
     };
 
-    std::string getSocketPath();
+    // Switches between the in-process core and hazkey-server. Returns false
+    // if the core could not be loaded; the server is used then.
+    bool setInProcess(bool inProcess);
+    bool isInProcess() const { return inProcessCore_ != nullptr; }
+
+    static std::string getSocketPath();
+
+    // snake_case name of the request payload, e.g. "get_candidates"
+    static const char* commandName(
+        hazkey::RequestEnvelope::PayloadCase command);
 
     void connectServer();
 
+    // From the Hello exchange on the last connection; 0 if the server
+    // predates Hello or could not be reached.
+    uint32_t serverProtocolVersion() const {
+        return serverHello_ ? serverHello_->protocol_version() : 0;
+    }
+    // Release version of the server, e.g. "0.2.1"; empty in the same cases.
+    std::string serverVersion() const {
+        return serverHello_ ? serverHello_->version() : std::string();
+    }
+    // Whether this addon can talk to the server at all; what it can do
+    // beyond that is told by serverSupports().
+    bool serverProtocolSupported() const {
+        return serverProtocolVersion() >= HAZKEY_MIN_PROTOCOL_VERSION &&
+               serverProtocolVersion() <= HAZKEY_PROTOCOL_VERSION;
+    }
+    // Whether both sides support an optional feature.
+    bool serverSupports(hazkey::commands::Hello::Feature feature) const {
+        return serverHello_ && (serverHello_->features() & feature) != 0;
+    }
+
     void startHazkeyServer(bool force_restart);
 
     std::optional<hazkey::ResponseEnvelope> transact(
@@ -35,9 +75,20 @@ class HazkeyServerConnector {
         hazkey::commands::GetComposingString::CharType type,
         std::string currentPreedit);
 
+    // Every F6-F10 form of the composition, from one request. The result is
+    // kept until a request that may change the composition is sent. nullopt
+    // without FEATURE_COMPOSING_VARIANTS or on error.
+    std::optional<hazkey::commands::ComposingVariants> getComposingVariants();
+
     fcitx::Text getComposingHiraganaWithCursor();
 
-    void inputChar(std::string text);
+    // With FEATURE_CLIENT_SUB_INPUT, sub-input mode is tracked here instead
+    // of on the server, and with `mayDefer` a character typed in it is kept
+    // until the next request rather than sent. Returns true if `text` was
+    // kept; the caller then shows it without asking the server.
+    bool inputChar(std::string text, bool mayDefer = false);
+    // whether typing is waiting to be sent with the next request
+    bool hasPendingInput() const { return !pendingDirectInput_.empty(); }
 
     void shiftKeyEvent(bool isRelease);
 
@@ -49,7 +100,8 @@ class HazkeyServerConnector {
 
     void moveCursor(int offset);
 
-    void setContext(std::string context, int anchor);
+    // `windowLength` is the context window setting `context` was cut to.
+    void setContext(std::string context, int anchor, int windowLength);
 
     void setServerConfig(int zenzaiEnabled, int zenzaiInferLimit,
                          int numberFullwidth, int symbolFullwidth,
@@ -69,13 +121,59 @@ class HazkeyServerConnector {
     };
 
     hazkey::commands::CandidatesResult getCandidates(bool isSuggest);
+    // Only live_text, live_text_index and page_size, without prediction or
+    // candidates. Needs FEATURE_LIVE_TEXT.
+    hazkey::commands::CandidatesResult getLiveText();
+
+    // Converts many readings at once, independent of the current
+    // composition. See ConvertBatch in commands.proto for the options.
+    std::optional<hazkey::commands::BatchResult> convertBatch(
+        const hazkey::commands::ConvertBatch& batch);
+
+    // number of requests sent so far, for benchmarking
+    uint64_t transactCount() const { return transactCount_; }
 
    private:
+    // Hello feature bits this client can use
+    static constexpr uint64_t kClientFeatures =
+        hazkey::commands::Hello::FEATURE_BATCH |
+        hazkey::commands::Hello::FEATURE_BENCHMARK |
+        hazkey::commands::Hello::FEATURE_COMPACT_CANDIDATES |
+        hazkey::commands::Hello::FEATURE_LIVE_TEXT |
+        hazkey::commands::Hello::FEATURE_COMPOSING_VARIANTS |
+        hazkey::commands::Hello::FEATURE_CLIENT_SUB_INPUT;
+
+    // Sends the characters kept by inputChar().
+    void flushDirectInput();
+    // Whether a request leaves the composing text as it is.
+    static bool keepsComposition(hazkey::RequestEnvelope::PayloadCase command);
+    std::optional<hazkey::ResponseEnvelope> sendAndReceive(
+        const hazkey::RequestEnvelope& send_data);
+    // Says Hello to a freshly connected server or in-process core.
+    void negotiate();
+    // One request on sock_, without reconnecting; closes sock_ on failure.
+    std::optional<hazkey::ResponseEnvelope> exchangeOnSocket(
+        const hazkey::RequestEnvelope& request);
+    // start recording if HAZKEY_RECORD_SESSION is set
+    void openSessionLog();
     bool retryConnect();
     bool isHazkeyServerRunning();
     bool requestSuccess(hazkey::ResponseEnvelope);
     int sock_ = -1;
     std::string socket_path_;
+    // hash of the last context the server accepted
+    std::optional<size_t> lastContextHash_;
+    uint64_t transactCount_ = 0;
+    std::shared_ptr<SessionLogWriter> sessionLog_;
+    std::shared_ptr<HazkeyInProcessCore> inProcessCore_;
+    std::optional<hazkey::commands::HelloResult> serverHello_;
+    // from getComposingVariants(), until the composition changes
+    std::optional<hazkey::commands::ComposingVariants> composingVariants_;
+    // sub-input mode, as HazkeyServerState tracks it without
+    // FEATURE_CLIENT_SUB_INPUT
+    bool subInputMode_ = false;
+    bool shiftPressedAlone_ = false;
+    std::string pendingDirectInput_;
 };
 
 #endif  // HAZKEY_SERVER_CONNECTOR_H
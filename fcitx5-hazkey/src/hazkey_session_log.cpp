@@ -0,0 +1,105 @@
+#include "hazkey_session_log.h"
+
+#include <memory>
+
+namespace {
+
+constexpr char MAGIC[] = "HZKSESS1";
+constexpr size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+constexpr uint32_t NO_RESPONSE = 0xffffffff;
+
+template <typename T>
+void writeInt(std::ofstream& out, T value) {
+    char bytes[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.write(bytes, sizeof(T));
+}
+
+template <typename T>
+bool readInt(std::ifstream& in, T& value) {
+    unsigned char bytes[sizeof(T)];
+    if (!in.read(reinterpret_cast<char*>(bytes), sizeof(T))) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(bytes[i]) << (8 * i);
+    }
+    return true;
+}
+
+bool readBytes(std::ifstream& in, uint32_t size, std::string& bytes) {
+    bytes.resize(size);
+    return static_cast<bool>(in.read(bytes.data(), size));
+}
+
+}  // namespace
+
+std::unique_ptr<SessionLogWriter> SessionLogWriter::open(
+    const std::string& path) {
+    std::unique_ptr<SessionLogWriter> writer(new SessionLogWriter());
+    writer->out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!writer->out_) {
+        return nullptr;
+    }
+    writer->out_.write(MAGIC, MAGIC_SIZE);
+    writer->openedAt_ = std::chrono::steady_clock::now();
+    return writer;
+}
+
+void SessionLogWriter::write(
+    const hazkey::RequestEnvelope& request,
+    const std::optional<hazkey::ResponseEnvelope>& response,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    std::string requestBytes = request.SerializeAsString();
+    std::string responseBytes;
+    if (response) {
+        responseBytes = response->SerializeAsString();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    writeInt<uint64_t>(out_,
+                       duration_cast<microseconds>(start - openedAt_).count());
+    writeInt<uint32_t>(out_, duration_cast<microseconds>(end - start).count());
+    writeInt<uint32_t>(out_, requestBytes.size());
+    out_.write(requestBytes.data(), requestBytes.size());
+    if (response) {
+        writeInt<uint32_t>(out_, responseBytes.size());
+        out_.write(responseBytes.data(), responseBytes.size());
+    } else {
+        writeInt<uint32_t>(out_, NO_RESPONSE);
+    }
+    // a crashed session should still leave a readable log
+    out_.flush();
+}
+
+bool SessionLogReader::open(const std::string& path) {
+    in_.open(path, std::ios::binary);
+    std::string magic;
+    return in_ && readBytes(in_, MAGIC_SIZE, magic) && magic == MAGIC;
+}
+
+std::optional<SessionRecord> SessionLogReader::next() {
+    SessionRecord record;
+    uint32_t size;
+    std::string bytes;
+    if (!readInt(in_, record.timeUs) || !readInt(in_, record.latencyUs) ||
+        !readInt(in_, size) || !readBytes(in_, size, bytes) ||
+        !record.request.ParseFromString(bytes) || !readInt(in_, size)) {
+        return std::nullopt;
+    }
+    if (size != NO_RESPONSE) {
+        hazkey::ResponseEnvelope response;
+        if (!readBytes(in_, size, bytes) || !response.ParseFromString(bytes)) {
+            return std::nullopt;
+        }
+        record.response = std::move(response);
+    }
+    return record;
+}
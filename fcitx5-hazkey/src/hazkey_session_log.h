@@ -0,0 +1,63 @@
+#ifndef _FCITX5_HAZKEY_HAZKEY_SESSION_LOG_H_
+#define _FCITX5_HAZKEY_HAZKEY_SESSION_LOG_H_
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "base.pb.h"
+
+// Binary log of the envelopes exchanged with hazkey-server. The connector
+// writes one when HAZKEY_RECORD_SESSION is set to a file path; hazkey-replay
+// reads it back. The log contains everything typed, so it is opt-in only.
+//
+// file:   "HZKSESS1" followed by records
+// record: u64 request time (us since the log was opened)
+//         u32 latency (us)
+//         u32 request size, request bytes
+//         u32 response size, response bytes
+// Integers are little-endian. The response size is 0xffffffff when the
+// transaction failed.
+
+struct SessionRecord {
+    uint64_t timeUs = 0;
+    uint32_t latencyUs = 0;
+    hazkey::RequestEnvelope request;
+    std::optional<hazkey::ResponseEnvelope> response;
+};
+
+class SessionLogWriter {
+   public:
+    // returns nullptr if the file cannot be created
+    static std::unique_ptr<SessionLogWriter> open(const std::string& path);
+
+    void write(const hazkey::RequestEnvelope& request,
+               const std::optional<hazkey::ResponseEnvelope>& response,
+               std::chrono::steady_clock::time_point start,
+               std::chrono::steady_clock::time_point end);
+
+   private:
+    SessionLogWriter() = default;
+
+    std::mutex mutex_;
+    std::ofstream out_;
+    std::chrono::steady_clock::time_point openedAt_;
+};
+
+class SessionLogReader {
+   public:
+    // false if the file cannot be opened or is not a session log
+    bool open(const std::string& path);
+
+    // next record, or nullopt at the end of the log
+    std::optional<SessionRecord> next();
+
+   private:
+    std::ifstream in_;
+};
+
+#endif  // _FCITX5_HAZKEY_HAZKEY_SESSION_LOG_H_
@@ -0,0 +1,21 @@
+#ifndef _FCITX5_HAZKEY_HAZKEY_SOCKET_PATH_H_
+#define _FCITX5_HAZKEY_HAZKEY_SOCKET_PATH_H_
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+
+// Where hazkey-server listens. Shared by the connector and the mock server,
+// which does not link fcitx.
+inline std::string hazkeySocketPath() {
+    const char* xdg_runtime_dir = std::getenv("XDG_RUNTIME_DIR");
+    std::string sockname =
+        "hazkey-server." + std::to_string(getuid()) + ".sock";
+    if (xdg_runtime_dir && xdg_runtime_dir[0] != '\0') {
+        return std::string(xdg_runtime_dir) + "/" + sockname;
+    }
+    return "/tmp/" + sockname;
+}
+
+#endif  // _FCITX5_HAZKEY_HAZKEY_SOCKET_PATH_H_
@@ -2,7 +2,9 @@
 
 #include <fcitx-utils/key.h>
 #include <fcitx-utils/log.h>
+#include <fcitx-utils/utf8.h>
 #include <fcitx/candidatelist.h>
+#include <fcitx/instance.h>
 
 #include <algorithm>
 #include <optional>
@@ -17,6 +19,44 @@
 
 namespace fcitx {
 
+namespace {
+
+// The server lists the alphabet cases in cycle order; show the one after the
+// current preedit.
+std::string nextAlphabetCase(
+    const google::protobuf::RepeatedPtrField<std::string>& cycle,
+    const std::string& preedit) {
+    if (cycle.empty()) {
+        return "";
+    }
+    for (int i = 0; i < cycle.size(); ++i) {
+        if (cycle[i] == preedit) {
+            return cycle[(i + 1) % cycle.size()];
+        }
+    }
+    return cycle[0];
+}
+
+std::string composingVariant(
+    const hazkey::commands::ComposingVariants& variants,
+    hazkey::commands::GetComposingString::CharType charType,
+    const std::string& preedit) {
+    switch (charType) {
+        case hazkey::commands::GetComposingString::KATAKANA_FULL:
+            return variants.katakana_full();
+        case hazkey::commands::GetComposingString::KATAKANA_HALF:
+            return variants.katakana_half();
+        case hazkey::commands::GetComposingString::ALPHABET_FULL:
+            return nextAlphabetCase(variants.alphabet_full(), preedit);
+        case hazkey::commands::GetComposingString::ALPHABET_HALF:
+            return nextAlphabetCase(variants.alphabet_half(), preedit);
+        default:
+            return variants.hiragana();
+    }
+}
+
+}  // namespace
+
 HazkeyState::HazkeyState(HazkeyEngine* engine, InputContext* ic)
     : engine_(engine), ic_(ic), preedit_(HazkeyPreedit(ic)) {
     engine_->server().newComposingText();
@@ -38,14 +78,24 @@ void HazkeyState::commitPreedit() { preedit_.commitPreedit(); }
 void HazkeyState::keyEvent(KeyEvent& event) {
     FCITX_DEBUG() << "HazkeyState keyEvent";
 
-    std::string composingText = engine_->server().getComposingText(
-        hazkey::commands::GetComposingString_CharType_HIRAGANA,
-        preedit_.text());
+    if (!event.isRelease()) {
+        // the list would be for a composition this key may change
+        suggestionListEvent_.reset();
+    }
+
+    // typing kept back in sub-input mode is not sent just to check this
+    bool composing =
+        engine_->server().hasPendingInput() ||
+        !engine_->server()
+             .getComposingText(
+                 hazkey::commands::GetComposingString_CharType_HIRAGANA,
+                 preedit_.text())
+             .empty();
 
     if (event.key().sym() == FcitxKey_Shift_L ||
         event.key().sym() == FcitxKey_Shift_R) {
         engine_->server().shiftKeyEvent(event.isRelease());
-        if (composingText == "") {
+        if (!composing) {
             setAuxDownText(std::nullopt);
             return;
         }
@@ -57,11 +107,11 @@ void HazkeyState::keyEvent(KeyEvent& event) {
     if (candidateList != nullptr && candidateList->focused() &&
         !event.isRelease()) {
         candidateKeyEvent(event, candidateList);
-    } else if (composingText != "" && !event.isRelease()) {
+    } else if (composing && !event.isRelease()) {
         preeditKeyEvent(event, candidateList);
     } else if (!event.isRelease()) {
         noPreeditKeyEvent(event);
-    } else if (composingText != "" && candidateList != nullptr &&
+    } else if (composing && candidateList != nullptr &&
                !candidateList->focused() &&
                engine_->config().showTabToSelect.value()) {
         setAuxDownText(std::string(_("[Press Tab to Select]")));
@@ -77,7 +127,7 @@ void HazkeyState::keyEvent(KeyEvent& event) {
         ic_->inputPanel().candidateList());
     if (newCandidateList != nullptr && newCandidateList->focused()) {
         setCandidateCursorAUX(newCandidateList);
-    } else if (composingText != "") {
+    } else if (composing) {
         setHiraganaAUX();
     }
 }
@@ -105,8 +155,7 @@ void HazkeyState::noPreeditKeyEvent(KeyEvent& event) {
         default:
             if (isInputableEvent(event)) {
                 updateSurroundingText();
-                engine_->server().inputChar(Key::keySymToUTF8(keysym));
-                showPreeditCandidateList();
+                inputText(Key::keySymToUTF8(keysym));
                 setHiraganaAUX();
             } else {
                 reset();
@@ -200,8 +249,7 @@ void HazkeyState::preeditKeyEvent(
                     preedit_.commitPreedit();
                     reset();
                 }
-                engine_->server().inputChar(Key::keySymToUTF8(keysym));
-                showPreeditCandidateList();
+                inputText(Key::keySymToUTF8(keysym));
             }
             break;
     }
@@ -286,8 +334,7 @@ void HazkeyState::candidateKeyEvent(
             } else if (isInputableEvent(event)) {
                 preedit_.commitPreedit();
                 reset();
-                engine_->server().inputChar(Key::keySymToUTF8(keysym));
-                showPreeditCandidateList();
+                inputText(Key::keySymToUTF8(keysym));
             } else {
                 return event.filter();
             }
@@ -316,11 +363,24 @@ void HazkeyState::updateSurroundingText(std::string appendText) {
     if (ic_->capabilityFlags().test(CapabilityFlag::SurroundingText) &&
         ic_->surroundingText().isValid()) {
         auto& surroundingText = ic_->surroundingText();
-        engine_->server().setContext(
-            surroundingText.text() + appendText,
-            surroundingText.anchor() + appendText.length());
+        const auto& text = surroundingText.text();
+        // anchor is counted in characters, not bytes
+        size_t anchor =
+            std::min<size_t>(surroundingText.anchor(), utf8::length(text));
+        std::string leftText =
+            text.substr(0, utf8::ncharByteLength(text.begin(), anchor)) +
+            appendText;
+
+        // only send a bounded window before the cursor
+        size_t leftLength = utf8::length(leftText);
+        int windowSetting = engine_->config().contextWindowLength.value();
+        size_t windowLength = std::min<size_t>(leftLength, windowSetting);
+        auto windowBegin =
+            utf8::nextNChar(leftText.begin(), leftLength - windowLength);
+        engine_->server().setContext(std::string(windowBegin, leftText.end()),
+                                     windowLength, windowSetting);
     } else {
-        engine_->server().setContext("", 0);
+        engine_->server().setContext("", 0, 0);
     }
 }
 
@@ -386,35 +446,30 @@ void HazkeyState::functionKeyHandler(KeyEvent& event) {
 }
 
 void HazkeyState::directCharactorConversion(ConversionMode mode) {
-    std::string converted;
-    // TODO: use protobuf type for all program
+    auto charType = hazkey::commands::GetComposingString::HIRAGANA;
     switch (mode) {
         case ConversionMode::Hiragana:
-            converted = engine_->server().getComposingText(
-                hazkey::commands::GetComposingString_CharType_HIRAGANA,
-                preedit_.text());
             break;
         case ConversionMode::KatakanaFullwidth:
-            converted = engine_->server().getComposingText(
-                hazkey::commands::GetComposingString_CharType_KATAKANA_FULL,
-                preedit_.text());
+            charType = hazkey::commands::GetComposingString::KATAKANA_FULL;
             break;
         case ConversionMode::KatakanaHalfwidth:
-            converted = engine_->server().getComposingText(
-                hazkey::commands::GetComposingString_CharType_KATAKANA_HALF,
-                preedit_.text());
+            charType = hazkey::commands::GetComposingString::KATAKANA_HALF;
             break;
         case ConversionMode::RawFullwidth:
-            converted = engine_->server().getComposingText(
-                hazkey::commands::GetComposingString_CharType_ALPHABET_FULL,
-                preedit_.text());
+            charType = hazkey::commands::GetComposingString::ALPHABET_FULL;
             break;
         case ConversionMode::RawHalfwidth:
-            converted = engine_->server().getComposingText(
-                hazkey::commands::GetComposingString_CharType_ALPHABET_HALF,
-                preedit_.text());
+            charType = hazkey::commands::GetComposingString::ALPHABET_HALF;
             break;
     }
+    // all forms come in one response, which the connector keeps until the
+    // composition changes, so cycling F9/F10 needs no further requests
+    auto variants = engine_->server().getComposingVariants();
+    std::string converted =
+        variants ? composingVariant(*variants, charType, preedit_.text())
+                 : engine_->server().getComposingText(charType,
+                                                      preedit_.text());
     preedit_.setSimplePreeditHighlighted(converted);
     livePreeditIndex_ = -1;
     auto candidateList = ic_->inputPanel().candidateList();
@@ -424,18 +479,54 @@ void HazkeyState::directCharactorConversion(ConversionMode mode) {
     }
 }
 
+void HazkeyState::inputText(const std::string& text) {
+    if (!engine_->server().inputChar(text, !isCursorMoving_)) {
+        showPreeditCandidateList();
+        return;
+    }
+    // Kept by the connector in sub-input mode, where nothing is converted:
+    // append it to what is shown. The server sees it with the next request.
+    preedit_.setSimplePreedit(preedit_.text() + text);
+    livePreeditIndex_ = -1;
+    ic_->inputPanel().setCandidateList(nullptr);
+    auto auxUp = ic_->inputPanel().auxUp();
+    if (auxUp.size() > 0) {
+        auxUp.append(text);
+        ic_->inputPanel().setAuxUp(auxUp);
+    }
+    setAuxDownText(std::nullopt);
+}
+
 /// Show Candidate List
 
 bool HazkeyState::showCandidateList(bool isSuggest) {
     FCITX_DEBUG() << "HazkeyState showCandidateList";
 
     auto response = engine_->server().getCandidates(isSuggest);
+    serverWarmingUp_ = response.warming_up();
 
-    auto candidateResult =
-        std::make_unique<HazkeyCandidateList>(std::move(response.candidates()));
+    auto candidateResult = std::make_unique<HazkeyCandidateList>(response);
 
     candidateResult->setSelectionKey(defaultSelectionKeys);
 
+    showLiveText(response);
+
+    if (response.page_size() > 0) {
+        ic_->inputPanel().setCandidateList(std::move(candidateResult));
+        auto newFcitxCandidateList =
+            std::dynamic_pointer_cast<HazkeyCandidateList>(
+                ic_->inputPanel().candidateList());
+        int pageSize = std::min(static_cast<size_t>(response.page_size()),
+                                defaultSelectionKeys.size());
+        newFcitxCandidateList->setPageSize(pageSize);
+    }
+
+    // true if the list is displayed
+    return response.page_size() > 0;
+}
+
+void HazkeyState::showLiveText(
+    const hazkey::commands::CandidatesResult& response) {
     ic_->inputPanel().reset();
 
     // TODO: check live preedit config
@@ -453,24 +544,17 @@ bool HazkeyState::showCandidateList(bool isSuggest) {
     }
 
     livePreeditIndex_ = response.live_text_index();
-
-    if (response.page_size() > 0) {
-        ic_->inputPanel().setCandidateList(std::move(candidateResult));
-        auto newFcitxCandidateList =
-            std::dynamic_pointer_cast<HazkeyCandidateList>(
-                ic_->inputPanel().candidateList());
-        int pageSize = std::min(static_cast<size_t>(response.page_size()),
-                                defaultSelectionKeys.size());
-        newFcitxCandidateList->setPageSize(pageSize);
-    }
-
-    // true if the list is displayed
-    return response.page_size() > 0;
 }
 
 void HazkeyState::showNonPredictCandidateList() {
     showCandidateList(false);
 
+    if (serverWarmingUp_) {
+        // no candidates until the server finishes loading the dictionary
+        setAuxDownText(std::string(_("[Warming up...]")));
+        return;
+    }
+
     livePreeditIndex_ = -1;
 
     // highlight all preedit text
@@ -495,8 +579,40 @@ void HazkeyState::showPreeditCandidateList() {
         reset();
         return;
     }
+    auto& server = engine_->server();
+    if (!server.serverSupports(hazkey::commands::Hello::FEATURE_LIVE_TEXT)) {
+        showSuggestionList();
+        return;
+    }
+
+    // The live text comes first, from a 1-best conversion without
+    // prediction. The predictive list is asked for once this key has been
+    // handled, and not at all if the next key comes first.
+    auto response = server.getLiveText();
+    serverWarmingUp_ = response.warming_up();
+    showLiveText(response);
+    if (response.page_size() > 0 && !serverWarmingUp_) {
+        suggestionListEvent_ = engine_->instance()->eventLoop().addDeferEvent(
+            [this](EventSource*) {
+                showSuggestionList();
+                setHiraganaAUX();
+                ic_->updatePreedit();
+                ic_->updateUserInterface(UserInterfaceComponent::InputPanel);
+                return true;
+            });
+    }
+    if (serverWarmingUp_) {
+        setAuxDownText(std::string(_("[Warming up...]")));
+    } else {
+        setAuxDownText(std::nullopt);
+    }
+}
+
+void HazkeyState::showSuggestionList() {
     if (showCandidateList(true) && engine_->config().showTabToSelect.value()) {
         setAuxDownText(std::string(_("[Press Tab to Select]")));
+    } else if (serverWarmingUp_) {
+        setAuxDownText(std::string(_("[Warming up...]")));
     } else {
         setAuxDownText(std::nullopt);
     }
@@ -546,6 +662,10 @@ void HazkeyState::setAuxDownText(std::optional<std::string> optText) {
 }
 
 void HazkeyState::setHiraganaAUX() {
+    if (engine_->server().hasPendingInput()) {
+        // inputText() has appended the kept characters
+        return;
+    }
     ic_->inputPanel().setAuxUp(
         engine_->server().getComposingHiraganaWithCursor());
 }
@@ -554,6 +674,7 @@ void HazkeyState::setHiraganaAUX() {
 
 void HazkeyState::reset() {
     FCITX_DEBUG() << "HazkeyState reset";
+    suggestionListEvent_.reset();
     isDirectConversionMode_ = false;
     livePreeditIndex_ = -1;
     isCursorMoving_ = false;
@@ -1,6 +1,7 @@
 #ifndef _FCITX5_HAZKEY_HAZKEY_STATE_H_
 #define _FCITX5_HAZKEY_HAZKEY_STATE_H_
 
+#include <fcitx-utils/event.h>
 #include <fcitx/inputcontext.h>
 #include <fcitx/inputpanel.h>
 #include <fcitx/surroundingtext.h>
@@ -47,6 +48,8 @@ class HazkeyState : public InputContextProperty {
     bool ctrlShortcutHandler(KeyEvent& keyEvent);
     // f6-f10 key handler
     void functionKeyHandler(KeyEvent& keyEvent);
+    // type text into the composition and show the result
+    void inputText(const std::string& text);
     // convert to hiragana/katakana/alphanumeric directly
     void directCharactorConversion(ConversionMode mode);
     // handle key event in normal mode (no preedit)
@@ -61,6 +64,8 @@ class HazkeyState : public InputContextProperty {
     // base function to prepare candidate list
     // make sure composingText_ is not nullptr
     bool showCandidateList(bool isSuggest);
+    // show the live text of a candidates result in the preedit
+    void showLiveText(const hazkey::commands::CandidatesResult& response);
     std::unique_ptr<HazkeyCandidateList> createCandidateList(
         std::vector<std::vector<std::string>> candidates,
         std::shared_ptr<std::vector<std::string>> preeditSegments);
@@ -71,6 +76,8 @@ class HazkeyState : public InputContextProperty {
     // list for prediction.
     // shorter than normal
     void showPreeditCandidateList();
+    // the suggestion list, after the live text has been shown
+    void showSuggestionList();
 
     // update the candidate cursor
     void updateCandidateCursor(
@@ -108,7 +115,11 @@ class HazkeyState : public InputContextProperty {
     bool isCursorMoving_ = false;
 
     bool isDirectConversionMode_ = false;
+    // server is still loading dictionary / zenzai model
+    bool serverWarmingUp_ = false;
     int livePreeditIndex_ = -1;
+    // pending showSuggestionList(), dropped by the next key press
+    std::unique_ptr<EventSource> suggestionListEvent_;
     // engine
     HazkeyEngine* engine_;
     // fcitx input context
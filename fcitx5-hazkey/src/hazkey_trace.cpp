@@ -0,0 +1,153 @@
+#include "hazkey_trace.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+int64_t toMicroseconds(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               time.time_since_epoch())
+        .count();
+}
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+// one write() per event, so that appends from both processes do not interleave
+void writeEvent(int fd, const std::string& event) {
+    std::string line = event + ",\n";
+    [[maybe_unused]] auto written = write(fd, line.data(), line.size());
+}
+
+}  // namespace
+
+HazkeyTrace& HazkeyTrace::instance() {
+    static HazkeyTrace trace;
+    return trace;
+}
+
+HazkeyTrace::HazkeyTrace() {
+    const char* path = std::getenv("HAZKEY_TRACE_FILE");
+    if (!path || path[0] == '\0') {
+        return;
+    }
+    fd_ = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (fd_ < 0) {
+        return;
+    }
+    pid_ = getpid();
+
+    struct stat st;
+    if (fstat(fd_, &st) == 0 && st.st_size == 0) {
+        [[maybe_unused]] auto written = write(fd_, "[\n", 2);
+    }
+    writeEvent(fd_, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" +
+                        std::to_string(pid_) +
+                        ",\"args\":{\"name\":\"fcitx5-hazkey\"}}");
+}
+
+HazkeyTrace::~HazkeyTrace() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+uint64_t HazkeyTrace::newTraceId() {
+    // unique across addon restarts that share a trace file
+    return (pid_ << 32) | ++nextTraceId_;
+}
+
+uint64_t HazkeyTrace::currentTraceId() {
+    if (!enabled()) {
+        return 0;
+    }
+    return currentTraceId_ != 0 ? currentTraceId_ : newTraceId();
+}
+
+void HazkeyTrace::writeSpan(std::string_view category, std::string_view name,
+                            uint64_t traceId,
+                            std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point end,
+                            std::string_view detail) {
+    if (!enabled()) {
+        return;
+    }
+    std::string event = "{\"name\":";
+    appendJsonString(event, name);
+    event += ",\"cat\":";
+    appendJsonString(event, category);
+    event += ",\"ph\":\"X\",\"ts\":" + std::to_string(toMicroseconds(start)) +
+             ",\"dur\":" + std::to_string(toMicroseconds(end) -
+                                          toMicroseconds(start)) +
+             ",\"pid\":" + std::to_string(pid_) +
+             ",\"tid\":" + std::to_string(gettid()) +
+             ",\"args\":{\"trace_id\":\"" + std::to_string(traceId) + "\"";
+    if (!detail.empty()) {
+        event += ",\"detail\":";
+        appendJsonString(event, detail);
+    }
+    event += "}}";
+    writeEvent(fd_, event);
+}
+
+TraceScope::TraceScope() {
+    auto& trace = HazkeyTrace::instance();
+    if (!trace.enabled()) {
+        return;
+    }
+    previous_ = trace.currentTraceId_;
+    id_ = trace.newTraceId();
+    trace.currentTraceId_ = id_;
+}
+
+TraceScope::~TraceScope() {
+    if (id_ != 0) {
+        HazkeyTrace::instance().currentTraceId_ = previous_;
+    }
+}
+
+TraceSpan::TraceSpan(const char* category, const char* name, uint64_t traceId)
+    : active_(HazkeyTrace::instance().enabled()),
+      category_(category),
+      name_(name),
+      traceId_(traceId) {
+    if (active_) {
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (active_) {
+        HazkeyTrace::instance().writeSpan(category_, name_, traceId_, start_,
+                                          std::chrono::steady_clock::now(),
+                                          detail_);
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef _FCITX5_HAZKEY_HAZKEY_TRACE_H_
+#define _FCITX5_HAZKEY_HAZKEY_TRACE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Chrome/Perfetto trace-event output, enabled by setting HAZKEY_TRACE_FILE to
+// a file path. hazkey-server reads the same variable and appends to the same
+// file, so one trace holds both processes on the same (monotonic) clock.
+// The server only sees the variable when it inherits it, i.e. when this addon
+// starts it; a server started by hazkey-settings writes no trace unless
+// hazkey-settings had the variable as well.
+// Every request carries the ID of the key event that caused it, and all spans
+// have it as the "trace_id" argument.
+//
+// The file uses the JSON array format without the closing bracket, which the
+// trace viewers accept, so that events from both processes can be appended
+// independently and a crash leaves a readable trace.
+class HazkeyTrace {
+   public:
+    static HazkeyTrace& instance();
+
+    bool enabled() const { return fd_ >= 0; }
+
+    // ID of the current key event, or a new one outside key events
+    uint64_t currentTraceId();
+
+    void writeSpan(std::string_view category, std::string_view name,
+                   uint64_t traceId,
+                   std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point end,
+                   std::string_view detail);
+
+   private:
+    friend class TraceScope;
+
+    HazkeyTrace();
+    ~HazkeyTrace();
+    uint64_t newTraceId();
+
+    int fd_ = -1;
+    uint64_t pid_ = 0;
+    uint32_t nextTraceId_ = 0;
+    uint64_t currentTraceId_ = 0;
+};
+
+// Makes a new trace ID current while it lives (one per key event).
+class TraceScope {
+   public:
+    TraceScope();
+    ~TraceScope();
+
+    uint64_t id() const { return id_; }
+
+   private:
+    uint64_t id_ = 0;
+    uint64_t previous_ = 0;
+};
+
+// Writes a complete event for its lifetime. Does nothing when tracing is
+// disabled.
+class TraceSpan {
+   public:
+    TraceSpan(const char* category, const char* name, uint64_t traceId);
+    ~TraceSpan();
+
+    bool active() const { return active_; }
+    // free-form text shown as the "detail" argument
+    void setDetail(std::string detail) { detail_ = std::move(detail); }
+
+   private:
+    bool active_;
+    const char* category_;
+    const char* name_;
+    uint64_t traceId_;
+    std::chrono::steady_clock::time_point start_;
+    std::string detail_;
+};
+
+#endif  // _FCITX5_HAZKEY_HAZKEY_TRACE_H_
@@ -0,0 +1,179 @@
+// Runs HazkeyServerConnector against the mock server: the Hello exchange and
+// the live-text request, then scripted faults: a dropped reply, an oversized
+// frame and a slow reply. The connector must report the failed request and
+// recover on the next one.
+//
+// usage: hazkey-connector-test
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "hazkey_constants.h"
+#include "hazkey_server_connector.h"
+#include "hazkey_socket_path.h"
+#include "mock_server.h"
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::fprintf(stderr, "  FAILED: %s\n", what.c_str());
+        ++failures;
+    }
+}
+
+hazkey::RequestEnvelope inputChar(const std::string& text) {
+    hazkey::RequestEnvelope request;
+    request.mutable_input_char()->set_text(text);
+    return request;
+}
+
+hazkey::RequestEnvelope getComposingString() {
+    hazkey::RequestEnvelope request;
+    request.mutable_get_composing_string()->set_char_type(
+        hazkey::commands::GetComposingString::HIRAGANA);
+    return request;
+}
+
+hazkey::RequestEnvelope getCandidates() {
+    hazkey::RequestEnvelope request;
+    request.mutable_get_candidates()->set_is_suggest(false);
+    return request;
+}
+
+void testHello() {
+    MockServer server(hazkeySocketPath());
+    expect(server.start(), "mock server starts");
+    HazkeyServerConnector connector;
+
+    expect(connector.serverProtocolVersion() == HAZKEY_PROTOCOL_VERSION,
+           "Hello reports the protocol version");
+    expect(connector.serverVersion() == "mock",
+           "Hello reports the server version");
+    expect(connector.serverProtocolSupported(),
+           "the server protocol is in the supported range");
+    expect(connector.serverSupports(hazkey::commands::Hello::FEATURE_LIVE_TEXT),
+           "features both sides support are enabled");
+    expect(!connector.serverSupports(hazkey::commands::Hello::FEATURE_BATCH),
+           "features the server lacks are disabled");
+}
+
+void testLiveText() {
+    MockServer server(hazkeySocketPath());
+    expect(server.start(), "mock server starts");
+    HazkeyServerConnector connector;
+
+    connector.inputChar("a");
+    connector.inputChar("b");
+    auto live = connector.getLiveText();
+    expect(live.live_text() == "ab", "live text is the composition");
+    expect(live.live_text_index() == 0, "live text index is reported");
+    expect(live.candidates_size() == 0, "no candidates are sent");
+    expect(live.page_size() > 0, "page size tells the list is on");
+}
+
+// The mock counts every parsed request, including the connector's Hello, so
+// with dropEvery = 3 the second request after connecting fails.
+void testDroppedReply() {
+    MockServer::Behavior behavior;
+    behavior.dropEvery = 3;
+    MockServer server(hazkeySocketPath(), behavior);
+    expect(server.start(), "mock server starts");
+    HazkeyServerConnector connector;
+
+    auto first = connector.transact(inputChar("a"));
+    expect(first && first->status() == hazkey::SUCCESS,
+           "request before the drop succeeds");
+    auto dropped = connector.transact(inputChar("b"));
+    expect(!dropped, "dropped reply is reported as a failure");
+
+    // reconnects; the mock keeps the composition across connections
+    auto after = connector.transact(getComposingString());
+    expect(after && after->status() == hazkey::SUCCESS,
+           "request after the drop succeeds");
+    expect(after && after->text() == "ab",
+           "request after the drop sees the composition");
+}
+
+void testOversizedFrame() {
+    MockServer::Behavior behavior;
+    behavior.oversizeEvery = 3;
+    MockServer server(hazkeySocketPath(), behavior);
+    expect(server.start(), "mock server starts");
+    HazkeyServerConnector connector;
+
+    auto first = connector.transact(inputChar("a"));
+    expect(first && first->status() == hazkey::SUCCESS,
+           "request before the oversized frame succeeds");
+    auto oversized = connector.transact(getCandidates());
+    expect(!oversized, "oversized frame is rejected");
+
+    auto after = connector.transact(getCandidates());
+    expect(after && after->has_candidates() &&
+               after->candidates().candidates_size() > 0,
+           "request after the oversized frame succeeds");
+}
+
+void testSlowReply() {
+    constexpr auto DELAY = std::chrono::milliseconds(300);
+    MockServer::Behavior behavior;
+    behavior.commandDelays[hazkey::RequestEnvelope::kGetCandidates] = DELAY;
+    MockServer server(hazkeySocketPath(), behavior);
+    expect(server.start(), "mock server starts");
+    HazkeyServerConnector connector;
+
+    connector.transact(inputChar("a"));
+    auto start = std::chrono::steady_clock::now();
+    auto slow = connector.transact(getCandidates());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    expect(slow && slow->has_candidates(), "slow reply is received");
+    expect(elapsed >= DELAY, "transact waits for the slow reply");
+
+    // other commands are not delayed
+    start = std::chrono::steady_clock::now();
+    auto fast = connector.transact(getComposingString());
+    elapsed = std::chrono::steady_clock::now() - start;
+    expect(fast && fast->text() == "a", "next reply is received");
+    expect(elapsed < DELAY, "next reply is not delayed");
+}
+
+}  // namespace
+
+int main() {
+    // a private socket, so a running hazkey-server is left alone
+    char runtimeDir[] = "/tmp/hazkey-connector-test.XXXXXX";
+    if (!mkdtemp(runtimeDir)) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    setenv("XDG_RUNTIME_DIR", runtimeDir, 1);
+
+    const std::vector<std::pair<const char*, std::function<void()>>> tests = {
+        {"hello", testHello},
+        {"live text", testLiveText},
+        {"dropped reply", testDroppedReply},
+        {"oversized frame", testOversizedFrame},
+        {"slow reply", testSlowReply},
+    };
+    for (const auto& [name, test] : tests) {
+        std::fprintf(stderr, "%s\n", name);
+        test();
+    }
+
+    std::filesystem::remove_all(runtimeDir);
+    if (failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::fprintf(stderr, "all checks passed\n");
+    return 0;
+}
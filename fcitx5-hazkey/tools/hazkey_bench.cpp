@@ -0,0 +1,253 @@
+// Replays key traces through HazkeyState with a headless fcitx instance and
+// reports per-key latency and the number of server requests per key.
+//
+// usage: hazkey-bench [--stub] [--iterations N] [TRACE...]
+
+#include <fcitx-utils/key.h>
+#include <fcitx-utils/utf8.h>
+#include <fcitx/event.h>
+#include <fcitx/inputcontext.h>
+#include <fcitx/inputcontextmanager.h>
+#include <fcitx/inputmethodentry.h>
+#include <fcitx/instance.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "hazkey_constants.h"
+#include "hazkey_engine.h"
+#include "hazkey_state.h"
+#include "mock_server.h"
+#include "percentile.h"
+
+namespace {
+
+// InputContext without a frontend. Committed text is fed back as surrounding
+// text, like an editor would.
+class BenchInputContext : public fcitx::InputContext {
+   public:
+    explicit BenchInputContext(fcitx::InputContextManager& manager)
+        : InputContext(manager, "hazkey-bench") {
+        created();
+        setCapabilityFlags(fcitx::CapabilityFlags{
+            fcitx::CapabilityFlag::Preedit,
+            fcitx::CapabilityFlag::SurroundingText});
+        surroundingText().setText("", 0, 0);
+    }
+    ~BenchInputContext() override { destroy(); }
+
+    const char* frontend() const override { return "hazkey-bench"; }
+
+   protected:
+    void commitStringImpl(const std::string& text) override {
+        committed_ += text;
+        auto length = fcitx::utf8::length(committed_);
+        surroundingText().setText(committed_, length, length);
+    }
+    void deleteSurroundingTextImpl(int, unsigned int) override {}
+    void forwardKeyImpl(const fcitx::ForwardKeyEvent&) override {}
+    void updatePreeditImpl() override {}
+
+   private:
+    std::string committed_;
+};
+
+enum class KeyClass { Input, Convert, Delete, Commit, Paging, Other };
+
+const char* keyClassName(KeyClass keyClass) {
+    switch (keyClass) {
+        case KeyClass::Input:
+            return "input";
+        case KeyClass::Convert:
+            return "convert";
+        case KeyClass::Delete:
+            return "delete";
+        case KeyClass::Commit:
+            return "commit";
+        case KeyClass::Paging:
+            return "paging";
+        case KeyClass::Other:
+            break;
+    }
+    return "other";
+}
+
+KeyClass classifyKey(const fcitx::Key& key) {
+    switch (key.sym()) {
+        case FcitxKey_space:
+            return KeyClass::Convert;
+        case FcitxKey_BackSpace:
+        case FcitxKey_Delete:
+            return KeyClass::Delete;
+        case FcitxKey_Return:
+            return KeyClass::Commit;
+        case FcitxKey_Left:
+        case FcitxKey_Right:
+        case FcitxKey_Up:
+        case FcitxKey_Down:
+        case FcitxKey_Tab:
+            return KeyClass::Paging;
+        default:
+            return key.isSimple() ? KeyClass::Input : KeyClass::Other;
+    }
+}
+
+struct Trace {
+    std::string name;
+    std::vector<fcitx::Key> keys;
+};
+
+// One fcitx key name per token ("a", "space", "BackSpace", ...). Lines
+// starting with '#' are comments.
+std::optional<Trace> loadTrace(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open trace: " << path << std::endl;
+        return std::nullopt;
+    }
+    Trace trace{path.filename().string(), {}};
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream tokens(line);
+        std::string token;
+        while (tokens >> token) {
+            fcitx::Key key(token);
+            if (!key.isValid()) {
+                std::cerr << path << ": unknown key " << token << std::endl;
+                return std::nullopt;
+            }
+            trace.keys.push_back(key);
+        }
+    }
+    return trace;
+}
+
+struct Samples {
+    std::vector<double> latenciesMs;
+    uint64_t requests = 0;
+};
+
+// Points the connector at a temporary runtime dir and marks the addon config
+// as up to date, so the engine does not try to start a real server.
+std::string prepareStubEnvironment() {
+    char dirTemplate[] = "/tmp/hazkey-bench-XXXXXX";
+    std::filesystem::path dir = mkdtemp(dirTemplate);
+    std::filesystem::create_directories(dir / "config/fcitx5/conf");
+    std::ofstream(dir / "config/fcitx5/conf/hazkey.conf")
+        << "LastVersion=" << HAZKEY_VERSION << "\n";
+    setenv("XDG_RUNTIME_DIR", dir.c_str(), 1);
+    setenv("XDG_CONFIG_HOME", (dir / "config").c_str(), 1);
+    return dir.string();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bool useStub = false;
+    int iterations = 5;
+    std::vector<std::filesystem::path> tracePaths;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--stub") {
+            useStub = true;
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "-h" || arg == "--help") {
+            std::cout << "usage: " << argv[0]
+                      << " [--stub] [--iterations N] [TRACE...]" << std::endl;
+            return 0;
+        } else {
+            tracePaths.push_back(arg);
+        }
+    }
+    if (tracePaths.empty()) {
+        for (const auto& entry :
+             std::filesystem::directory_iterator(HAZKEY_BENCH_TRACE_DIR)) {
+            if (entry.path().extension() == ".keys") {
+                tracePaths.push_back(entry.path());
+            }
+        }
+        std::sort(tracePaths.begin(), tracePaths.end());
+    }
+
+    std::vector<Trace> traces;
+    for (const auto& path : tracePaths) {
+        auto trace = loadTrace(path);
+        if (!trace) {
+            return 1;
+        }
+        traces.push_back(std::move(*trace));
+    }
+
+    std::unique_ptr<MockServer> stub;
+    std::string stubDir;
+    if (useStub) {
+        stubDir = prepareStubEnvironment();
+        stub = std::make_unique<MockServer>(
+            HazkeyServerConnector::getSocketPath());
+        if (!stub->start()) {
+            return 1;
+        }
+    }
+
+    char* instanceArgv[] = {argv[0]};
+    fcitx::Instance instance(1, instanceArgv);
+    fcitx::HazkeyEngine engine(&instance);
+    fcitx::InputMethodEntry entry("hazkey", "Hazkey", "ja", "hazkey");
+    BenchInputContext ic(instance.inputContextManager());
+
+    std::map<KeyClass, Samples> samples;
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        for (const auto& trace : traces) {
+            ic.propertyFor(engine.factory())->reset();
+            for (const auto& key : trace.keys) {
+                fcitx::KeyEvent event(&ic, key);
+                auto requestsBefore = engine.server().transactCount();
+                auto start = std::chrono::steady_clock::now();
+                engine.keyEvent(entry, event);
+                auto end = std::chrono::steady_clock::now();
+
+                auto& classSamples = samples[classifyKey(key)];
+                classSamples.latenciesMs.push_back(
+                    std::chrono::duration<double, std::milli>(end - start)
+                        .count());
+                classSamples.requests +=
+                    engine.server().transactCount() - requestsBefore;
+            }
+        }
+    }
+
+    std::cout << "server: " << (useStub ? "stub" : "hazkey-server")
+              << ", traces: " << traces.size()
+              << ", iterations: " << iterations << std::endl;
+    std::printf("%-8s %7s %9s %9s %9s %8s\n", "class", "keys", "p50(ms)",
+                "p95(ms)", "p99(ms)", "rpc/key");
+    for (const auto& [keyClass, classSamples] : samples) {
+        const auto& latencies = classSamples.latenciesMs;
+        std::printf("%-8s %7zu %9.3f %9.3f %9.3f %8.2f\n",
+                    keyClassName(keyClass), latencies.size(),
+                    percentile(latencies, 0.50), percentile(latencies, 0.95),
+                    percentile(latencies, 0.99),
+                    (double)classSamples.requests / latencies.size());
+    }
+
+    if (stub) {
+        stub->stop();
+        std::filesystem::remove_all(stubDir);
+    }
+    return 0;
+}
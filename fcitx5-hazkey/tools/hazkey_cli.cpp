@@ -0,0 +1,145 @@
+// Converts hiragana readings from stdin, one per line, with hazkey-server's
+// ConvertBatch and prints the candidates as "reading<TAB>candidate...".
+//
+// usage: hazkey-cli [-n N] [-j WORKERS] [--batch SIZE]
+//
+// Lines are sent in batches of SIZE (default 32) so output streams while
+// input is read. Throughput and per-item latency are printed to stderr at the
+// end. Batch conversion does not use or change the learning data.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "hazkey_server_connector.h"
+#include "percentile.h"
+
+namespace {
+
+struct Totals {
+    uint64_t items = 0;
+    uint64_t failures = 0;
+    std::vector<double> itemLatenciesMs;
+    std::vector<double> batchLatenciesMs;
+};
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program << " [-n N] [-j WORKERS] [--batch SIZE]"
+              << std::endl;
+}
+
+void convertChunk(HazkeyServerConnector& server,
+                  const std::vector<std::string>& inputs, int nBest,
+                  int workers, Totals& totals) {
+    hazkey::commands::ConvertBatch batch;
+    for (const auto& input : inputs) {
+        batch.add_inputs(input);
+    }
+    batch.set_n_best(nBest);
+    batch.set_workers(workers);
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = server.convertBatch(batch);
+    totals.batchLatenciesMs.push_back(
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    totals.items += inputs.size();
+
+    if (!result || result->items_size() != static_cast<int>(inputs.size())) {
+        totals.failures += inputs.size();
+        for (const auto& input : inputs) {
+            std::cout << input << '\n';
+        }
+        return;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto& item = result->items(i);
+        std::cout << inputs[i];
+        for (const auto& candidate : item.candidates()) {
+            std::cout << '\t' << candidate;
+        }
+        std::cout << '\n';
+        totals.itemLatenciesMs.push_back(item.latency_us() / 1000.0);
+    }
+    std::cout.flush();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int nBest = 1;
+    int workers = 0;
+    size_t batchSize = 32;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "-n" || arg == "-j" || arg == "--batch") && i + 1 < argc) {
+            int value = std::atoi(argv[++i]);
+            if (value <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            if (arg == "-n") {
+                nBest = value;
+            } else if (arg == "-j") {
+                workers = value;
+            } else {
+                batchSize = value;
+            }
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    HazkeyServerConnector server;
+    Totals totals;
+    std::vector<std::string> chunk;
+    auto start = std::chrono::steady_clock::now();
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+        chunk.push_back(line);
+        if (chunk.size() >= batchSize) {
+            convertChunk(server, chunk, nBest, workers, totals);
+            chunk.clear();
+        }
+    }
+    if (!chunk.empty()) {
+        convertChunk(server, chunk, nBest, workers, totals);
+    }
+    double elapsedSec = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+
+    if (totals.items == 0) {
+        return 0;
+    }
+    const auto& latencies = totals.itemLatenciesMs;
+    std::fprintf(stderr,
+                 "sentences: %llu, failed: %llu, elapsed: %.3fs, "
+                 "throughput: %.1f sentences/s\n",
+                 (unsigned long long)totals.items,
+                 (unsigned long long)totals.failures, elapsedSec,
+                 totals.items / elapsedSec);
+    std::fprintf(stderr,
+                 "per-item latency (ms): p50 %.3f, p95 %.3f, p99 %.3f, "
+                 "max %.3f\n",
+                 percentile(latencies, 0.50), percentile(latencies, 0.95),
+                 percentile(latencies, 0.99), percentile(latencies, 1.0));
+    std::fprintf(stderr, "per-batch round trip (ms): p50 %.3f, p95 %.3f\n",
+                 percentile(totals.batchLatenciesMs, 0.50),
+                 percentile(totals.batchLatenciesMs, 0.95));
+    return totals.failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,330 @@
+// Runs a corpus of (reading, left context, expected output) through
+// hazkey-server under several profile settings and prints top-1/top-k
+// accuracy and conversion latency for each, to tune settings such as
+// zenzai_infer_limit and to catch accuracy and latency regressions together.
+//
+// usage: hazkey-eval [--tsv] [--misses] [--variant NAME:KEY=VALUE,...]...
+//                    [CORPUS]
+//
+// The corpus is a TSV file; lines starting with '#' are comments. Without
+// CORPUS the bundled eval/corpus.tsv is used. Each variant is applied on top
+// of the active profile; supported keys are zenzai_enable,
+// zenzai_infer_limit, zenzai_contextual_mode and num_candidates_per_page.
+// Without --variant, a built-in set comparing the lattice search with
+// several Zenzai settings is run.
+//
+// Conversions use ConvertBatch with use_profile and the variant's profile,
+// so they see Zenzai and the learning data like key strokes would. The
+// server converts them apart from the composition and the user's profile is
+// never changed, so the tool can be interrupted at any time.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hazkey_server_connector.h"
+#include "percentile.h"
+
+namespace {
+
+struct CorpusEntry {
+    std::string reading;
+    std::string leftContext;
+    std::string expected;
+};
+
+struct Variant {
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> settings;
+};
+
+struct VariantResult {
+    std::string name;
+    int k = 0;
+    size_t total = 0;
+    size_t top1 = 0;
+    size_t topK = 0;
+    size_t failures = 0;
+    std::vector<double> latenciesMs;
+    double elapsedSec = 0;
+    std::vector<std::string> misses;
+};
+
+// sent per request, to stay well under the connector's read timeout
+constexpr size_t kChunkSize = 8;
+
+const std::vector<Variant> kDefaultVariants = {
+    {"lattice", {{"zenzai_enable", "0"}}},
+    {"zenzai-1",
+     {{"zenzai_enable", "1"},
+      {"zenzai_infer_limit", "1"},
+      {"zenzai_contextual_mode", "0"}}},
+    {"zenzai-5",
+     {{"zenzai_enable", "1"},
+      {"zenzai_infer_limit", "5"},
+      {"zenzai_contextual_mode", "0"}}},
+    {"zenzai-10",
+     {{"zenzai_enable", "1"},
+      {"zenzai_infer_limit", "10"},
+      {"zenzai_contextual_mode", "0"}}},
+    {"zenzai-10-context",
+     {{"zenzai_enable", "1"},
+      {"zenzai_infer_limit", "10"},
+      {"zenzai_contextual_mode", "1"}}},
+};
+
+std::vector<std::string> split(const std::string& text, char separator) {
+    std::vector<std::string> fields;
+    std::stringstream stream(text);
+    std::string field;
+    while (std::getline(stream, field, separator)) {
+        fields.push_back(field);
+    }
+    if (!text.empty() && text.back() == separator) {
+        fields.emplace_back();
+    }
+    return fields;
+}
+
+std::optional<std::vector<CorpusEntry>> loadCorpus(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::vector<CorpusEntry> corpus;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        auto fields = split(line, '\t');
+        if (fields.size() != 3 || fields[0].empty() || fields[2].empty()) {
+            std::cerr << path << ":" << lineNumber
+                      << ": expected reading<TAB>context<TAB>expected"
+                      << std::endl;
+            return std::nullopt;
+        }
+        corpus.push_back({fields[0], fields[1], fields[2]});
+    }
+    return corpus;
+}
+
+std::optional<Variant> parseVariant(const std::string& spec) {
+    auto colon = spec.find(':');
+    if (colon == std::string::npos || colon == 0) {
+        return std::nullopt;
+    }
+    Variant variant{spec.substr(0, colon), {}};
+    for (const auto& setting : split(spec.substr(colon + 1), ',')) {
+        auto equal = setting.find('=');
+        if (equal == std::string::npos) {
+            return std::nullopt;
+        }
+        variant.settings.emplace_back(setting.substr(0, equal),
+                                      setting.substr(equal + 1));
+    }
+    return variant;
+}
+
+bool applySetting(hazkey::config::Profile& profile, const std::string& key,
+                  const std::string& value) {
+    int number = std::atoi(value.c_str());
+    if (key == "zenzai_enable") {
+        profile.set_zenzai_enable(number != 0);
+    } else if (key == "zenzai_infer_limit") {
+        profile.set_zenzai_infer_limit(number);
+    } else if (key == "zenzai_contextual_mode") {
+        profile.set_zenzai_contextual_mode(number != 0);
+    } else if (key == "num_candidates_per_page") {
+        profile.set_num_candidates_per_page(number);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::optional<hazkey::config::CurrentConfig> getConfig(
+    HazkeyServerConnector& server) {
+    hazkey::RequestEnvelope request;
+    request.mutable_get_config();
+    auto response = server.transact(request);
+    if (!response || response->status() != hazkey::SUCCESS ||
+        !response->has_current_config() ||
+        response->current_config().profiles_size() == 0) {
+        return std::nullopt;
+    }
+    return response->current_config();
+}
+
+VariantResult runVariant(HazkeyServerConnector& server,
+                         const std::vector<CorpusEntry>& corpus,
+                         const std::string& name,
+                         const hazkey::config::Profile& profile) {
+    int k = std::max(1, profile.num_candidates_per_page());
+    VariantResult result;
+    result.name = name;
+    result.k = k;
+    result.total = corpus.size();
+
+    // not measured: the first conversion after a settings change loads the
+    // Zenzai model
+    hazkey::commands::ConvertBatch warmUp;
+    warmUp.set_use_profile(true);
+    *warmUp.mutable_profile() = profile;
+    warmUp.add_inputs(corpus[0].reading);
+    server.convertBatch(warmUp);
+
+    for (size_t begin = 0; begin < corpus.size(); begin += kChunkSize) {
+        size_t end = std::min(begin + kChunkSize, corpus.size());
+        hazkey::commands::ConvertBatch batch;
+        batch.set_use_profile(true);
+        *batch.mutable_profile() = profile;
+        batch.set_n_best(k);
+        for (size_t i = begin; i < end; ++i) {
+            batch.add_inputs(corpus[i].reading);
+            batch.add_left_contexts(corpus[i].leftContext);
+        }
+
+        auto converted = server.convertBatch(batch);
+        if (!converted || converted->items_size() != batch.inputs_size()) {
+            result.failures += end - begin;
+            continue;
+        }
+        result.elapsedSec += converted->elapsed_us() / 1e6;
+        for (size_t i = begin; i < end; ++i) {
+            const auto& item = converted->items(i - begin);
+            const auto& candidates = item.candidates();
+            result.latenciesMs.push_back(item.latency_us() / 1000.0);
+            if (!candidates.empty() && candidates[0] == corpus[i].expected) {
+                ++result.top1;
+            }
+            if (std::find(candidates.begin(), candidates.end(),
+                          corpus[i].expected) != candidates.end()) {
+                ++result.topK;
+            } else {
+                result.misses.push_back(
+                    corpus[i].reading + ": expected " + corpus[i].expected +
+                    ", got " + (candidates.empty() ? "-" : candidates[0]));
+            }
+        }
+    }
+    return result;
+}
+
+void printResults(const std::vector<VariantResult>& results, bool tsv) {
+    if (tsv) {
+        std::printf(
+            "variant\tk\ttop1\ttopk\tp50_ms\tp99_ms\telapsed_s\tfailed\n");
+    } else {
+        std::printf("%-20s %4s %8s %8s %9s %9s %10s %6s\n", "variant", "k",
+                    "top-1", "top-k", "p50(ms)", "p99(ms)", "elapsed(s)",
+                    "failed");
+    }
+    for (const auto& result : results) {
+        size_t converted = result.total - result.failures;
+        double top1 = converted ? 100.0 * result.top1 / converted : 0;
+        double topK = converted ? 100.0 * result.topK / converted : 0;
+        std::printf(tsv ? "%s\t%d\t%.1f\t%.1f\t%.3f\t%.3f\t%.3f\t%zu\n"
+                        : "%-20s %4d %7.1f%% %7.1f%% %9.3f %9.3f %10.3f %6zu\n",
+                    result.name.c_str(), result.k, top1, topK,
+                    percentile(result.latenciesMs, 0.50),
+                    percentile(result.latenciesMs, 0.99), result.elapsedSec,
+                    result.failures);
+    }
+}
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program
+              << " [--tsv] [--misses] [--variant NAME:KEY=VALUE,...]... "
+                 "[CORPUS]"
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bool tsv = false;
+    bool showMisses = false;
+    std::string corpusPath = HAZKEY_EVAL_CORPUS;
+    std::vector<Variant> variants;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tsv") {
+            tsv = true;
+        } else if (arg == "--misses") {
+            showMisses = true;
+        } else if (arg == "--variant" && i + 1 < argc) {
+            auto variant = parseVariant(argv[++i]);
+            if (!variant) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            variants.push_back(std::move(*variant));
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] != '-') {
+            corpusPath = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (variants.empty()) {
+        variants = kDefaultVariants;
+    }
+
+    auto corpus = loadCorpus(corpusPath);
+    if (!corpus || corpus->empty()) {
+        std::cerr << "Failed to load corpus: " << corpusPath << std::endl;
+        return 1;
+    }
+
+    HazkeyServerConnector server;
+    auto config = getConfig(server);
+    if (!config) {
+        std::cerr << "Failed to get the configuration from hazkey-server"
+                  << std::endl;
+        return 1;
+    }
+    if (!config->zenzai_model_available()) {
+        std::cerr << "Zenzai is not available; Zenzai variants fall back to "
+                     "the lattice search"
+                  << std::endl;
+    }
+
+    std::vector<VariantResult> results;
+    for (const auto& variant : variants) {
+        hazkey::config::Profile profile = config->profiles(0);
+        for (const auto& [key, value] : variant.settings) {
+            if (!applySetting(profile, key, value)) {
+                std::cerr << "Unknown setting: " << key << std::endl;
+                return 1;
+            }
+        }
+        std::cerr << "Running " << variant.name << "..." << std::endl;
+        results.push_back(runVariant(server, *corpus, variant.name, profile));
+    }
+
+    printResults(results, tsv);
+    if (showMisses) {
+        for (const auto& result : results) {
+            for (const auto& miss : result.misses) {
+                std::printf("%s\t%s\n", result.name.c_str(), miss.c_str());
+            }
+        }
+    }
+    return 0;
+}
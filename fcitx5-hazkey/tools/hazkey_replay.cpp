@@ -0,0 +1,146 @@
+// Replays a session recorded with HAZKEY_RECORD_SESSION against a running
+// hazkey-server and reports per-command throughput and latency. A command's
+// throughput is how many of its requests the server answers per second of
+// time spent on them, so it does not depend on the other commands or on
+// --paced.
+//
+// usage: hazkey-replay [--paced] [--no-check] LOG
+//
+// By default requests are sent back to back. With --paced they are sent at
+// the times they were recorded. Unless --no-check is given, each response is
+// compared with the recorded one; learning and model changes between the
+// recording and the replay show up as mismatches.
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hazkey_server_connector.h"
+#include "hazkey_session_log.h"
+#include "percentile.h"
+
+namespace {
+
+struct CommandStats {
+    std::vector<double> latenciesMs;
+    std::vector<double> recordedLatenciesMs;
+    uint64_t failures = 0;
+    uint64_t mismatches = 0;
+};
+
+bool sameResponse(const std::optional<hazkey::ResponseEnvelope>& recorded,
+                  const std::optional<hazkey::ResponseEnvelope>& replayed) {
+    if (!recorded || !replayed) {
+        return recorded.has_value() == replayed.has_value();
+    }
+    return recorded->SerializeAsString() == replayed->SerializeAsString();
+}
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program << " [--paced] [--no-check] LOG"
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bool paced = false;
+    bool check = true;
+    std::string logPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--paced") {
+            paced = true;
+        } else if (arg == "--no-check") {
+            check = false;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (logPath.empty()) {
+            logPath = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (logPath.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<SessionRecord> records;
+    SessionLogReader reader;
+    if (!reader.open(logPath)) {
+        std::cerr << "Not a hazkey session log: " << logPath << std::endl;
+        return 1;
+    }
+    while (auto record = reader.next()) {
+        records.push_back(std::move(*record));
+    }
+    if (records.empty()) {
+        std::cerr << "Session log is empty: " << logPath << std::endl;
+        return 1;
+    }
+
+    // do not record the replay into another log
+    unsetenv("HAZKEY_RECORD_SESSION");
+    HazkeyServerConnector server;
+
+    std::map<hazkey::RequestEnvelope::PayloadCase, CommandStats> stats;
+    auto replayStart = std::chrono::steady_clock::now();
+    for (const auto& record : records) {
+        if (paced) {
+            std::this_thread::sleep_until(
+                replayStart + std::chrono::microseconds(record.timeUs));
+        }
+        auto start = std::chrono::steady_clock::now();
+        auto response = server.transact(record.request);
+        auto end = std::chrono::steady_clock::now();
+
+        auto& commandStats = stats[record.request.payload_case()];
+        commandStats.latenciesMs.push_back(
+            std::chrono::duration<double, std::milli>(end - start).count());
+        commandStats.recordedLatenciesMs.push_back(record.latencyUs / 1000.0);
+        if (!response) {
+            ++commandStats.failures;
+        }
+        if (check && !sameResponse(record.response, response)) {
+            ++commandStats.mismatches;
+        }
+    }
+    double elapsedSec = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - replayStart)
+                            .count();
+
+    std::cout << "requests: " << records.size() << ", mode: "
+              << (paced ? "paced" : "max") << ", elapsed: " << elapsedSec
+              << "s, throughput: " << records.size() / elapsedSec << " req/s"
+              << std::endl;
+    std::printf("%-26s %7s %9s %9s %9s %9s %13s %6s %8s\n", "command",
+                "count", "req/s", "p50(ms)", "p95(ms)", "p99(ms)",
+                "recorded p50", "failed", "mismatch");
+    for (const auto& [command, commandStats] : stats) {
+        const auto& latencies = commandStats.latenciesMs;
+        double busyMs = 0;
+        for (double latency : latencies) {
+            busyMs += latency;
+        }
+        std::printf("%-26s %7zu %9.1f %9.3f %9.3f %9.3f %13.3f %6llu %8s\n",
+                    HazkeyServerConnector::commandName(command),
+                    latencies.size(),
+                    busyMs > 0 ? latencies.size() * 1000.0 / busyMs : 0.0,
+                    percentile(latencies, 0.50),
+                    percentile(latencies, 0.95), percentile(latencies, 0.99),
+                    percentile(commandStats.recordedLatenciesMs, 0.50),
+                    (unsigned long long)commandStats.failures,
+                    check ? std::to_string(commandStats.mismatches).c_str()
+                          : "-");
+    }
+    return 0;
+}
@@ -0,0 +1,306 @@
+#include "mock_server.h"
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "commands.pb.h"
+
+namespace {
+
+constexpr int NUM_CANDIDATES = 9;
+constexpr int NUM_SUGGESTIONS = 4;
+// optional features answered in Hello
+constexpr uint64_t MOCK_FEATURES = hazkey::commands::Hello::FEATURE_LIVE_TEXT;
+constexpr uint32_t MAX_REQUEST_SIZE = 2 * 1024 * 1024;
+// above the 2MB response limit of HazkeyServerConnector
+constexpr uint32_t OVERSIZED_RESPONSE_SIZE = 4 * 1024 * 1024;
+
+bool readFull(int fd, void* data, size_t len) {
+    size_t received = 0;
+    while (received < len) {
+        ssize_t n = read(fd, (char*)data + received, len - received);
+        if (n <= 0) {
+            return false;
+        }
+        received += n;
+    }
+    return true;
+}
+
+bool writeFull(int fd, const void* data, size_t len) {
+    size_t sent = 0;
+    while (sent < len) {
+        ssize_t n =
+            send(fd, (const char*)data + sent, len - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+// split UTF-8 text into characters
+std::vector<std::string> splitChars(const std::string& text) {
+    std::vector<std::string> chars;
+    for (size_t i = 0; i < text.size();) {
+        size_t len = 1;
+        unsigned char c = text[i];
+        if (c >= 0xF0) {
+            len = 4;
+        } else if (c >= 0xE0) {
+            len = 3;
+        } else if (c >= 0xC0) {
+            len = 2;
+        }
+        chars.push_back(text.substr(i, len));
+        i += len;
+    }
+    return chars;
+}
+
+std::string joinChars(const std::vector<std::string>& chars, size_t begin,
+                      size_t end) {
+    std::string text;
+    for (size_t i = begin; i < end && i < chars.size(); ++i) {
+        text += chars[i];
+    }
+    return text;
+}
+
+}  // namespace
+
+MockServer::MockServer(std::string socketPath)
+    : MockServer(std::move(socketPath), Behavior()) {}
+
+MockServer::MockServer(std::string socketPath, Behavior behavior)
+    : socketPath_(std::move(socketPath)), behavior_(std::move(behavior)) {}
+
+MockServer::~MockServer() { stop(); }
+
+bool MockServer::start() {
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        std::cerr << "mock server: failed to create socket" << std::endl;
+        return false;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath_.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(socketPath_.c_str());
+    if (bind(listenFd_, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(listenFd_, 4) != 0) {
+        std::cerr << "mock server: failed to listen on " << socketPath_
+                  << std::endl;
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    thread_ = std::thread(&MockServer::serve, this);
+    return true;
+}
+
+void MockServer::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    close(listenFd_);
+    listenFd_ = -1;
+    unlink(socketPath_.c_str());
+}
+
+void MockServer::serve() {
+    while (running_) {
+        pollfd pfd{listenFd_, POLLIN, 0};
+        if (poll(&pfd, 1, 100) <= 0) {
+            continue;
+        }
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        serveClient(fd);
+        close(fd);
+    }
+}
+
+void MockServer::serveClient(int fd) {
+    while (running_) {
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, 100);
+        if (ready == 0) {
+            continue;
+        }
+        if (ready < 0) {
+            return;
+        }
+
+        uint32_t lenBuf;
+        if (!readFull(fd, &lenBuf, 4)) {
+            return;
+        }
+        uint32_t len = ntohl(lenBuf);
+        if (len > MAX_REQUEST_SIZE) {
+            return;
+        }
+        std::string buf(len, '\0');
+        if (!readFull(fd, buf.data(), len)) {
+            return;
+        }
+
+        hazkey::RequestEnvelope request;
+        hazkey::ResponseEnvelope response;
+        // faults count parsed requests only
+        bool parsed = request.ParseFromString(buf);
+        if (parsed) {
+            ++requestCount_;
+            response = handle(request);
+        } else {
+            response.set_status(hazkey::FAILED);
+            response.set_error_message("failed to parse request");
+        }
+
+        auto delay = behavior_.delay;
+        if (auto it = behavior_.commandDelays.find(request.payload_case());
+            it != behavior_.commandDelays.end()) {
+            delay = it->second;
+        }
+        if (delay.count() > 0) {
+            std::this_thread::sleep_for(delay);
+        }
+
+        uint64_t count = requestCount_;
+        if (parsed && behavior_.dropEvery > 0 &&
+            count % behavior_.dropEvery == 0) {
+            return;
+        }
+        if (parsed && behavior_.oversizeEvery > 0 &&
+            count % behavior_.oversizeEvery == 0) {
+            // only the length is sent; the client must give up on it
+            uint32_t outLen = htonl(OVERSIZED_RESPONSE_SIZE);
+            writeFull(fd, &outLen, 4);
+            return;
+        }
+
+        std::string out;
+        response.SerializeToString(&out);
+        uint32_t outLen = htonl(out.size());
+        if (!writeFull(fd, &outLen, 4) ||
+            !writeFull(fd, out.data(), out.size())) {
+            return;
+        }
+    }
+}
+
+hazkey::ResponseEnvelope MockServer::handle(
+    const hazkey::RequestEnvelope& request) {
+    hazkey::ResponseEnvelope response;
+    response.set_status(hazkey::SUCCESS);
+
+    switch (request.payload_case()) {
+        case hazkey::RequestEnvelope::kHello: {
+            // speaks the client's protocol, with the features it implements
+            auto* hello = response.mutable_hello_result();
+            hello->set_protocol_version(request.hello().protocol_version());
+            hello->set_features(request.hello().features() & MOCK_FEATURES);
+            hello->set_version("mock");
+            break;
+        }
+        case hazkey::RequestEnvelope::kNewComposingText:
+            composing_.clear();
+            cursor_ = 0;
+            break;
+        case hazkey::RequestEnvelope::kInputChar: {
+            auto chars = splitChars(request.input_char().text());
+            composing_.insert(composing_.begin() + cursor_, chars.begin(),
+                              chars.end());
+            cursor_ += chars.size();
+            break;
+        }
+        case hazkey::RequestEnvelope::kDeleteLeft:
+            if (cursor_ > 0) {
+                composing_.erase(composing_.begin() + --cursor_);
+            }
+            break;
+        case hazkey::RequestEnvelope::kDeleteRight:
+            if (cursor_ < composing_.size()) {
+                composing_.erase(composing_.begin() + cursor_);
+            }
+            break;
+        case hazkey::RequestEnvelope::kMoveCursor: {
+            long cursor = (long)cursor_ + request.move_cursor().offset();
+            cursor_ = std::clamp(cursor, 0L, (long)composing_.size());
+            break;
+        }
+        case hazkey::RequestEnvelope::kPrefixComplete:
+            // every candidate covers the whole composing text
+            composing_.clear();
+            cursor_ = 0;
+            break;
+        case hazkey::RequestEnvelope::kGetComposingString:
+            response.set_text(joinChars(composing_, 0, composing_.size()));
+            break;
+        case hazkey::RequestEnvelope::kGetHiraganaWithCursor: {
+            auto* textWithCursor = response.mutable_text_with_cursor();
+            textWithCursor->set_beforecursosr(
+                joinChars(composing_, 0, cursor_));
+            textWithCursor->set_oncursor(
+                joinChars(composing_, cursor_, cursor_ + 1));
+            textWithCursor->set_aftercursor(
+                joinChars(composing_, cursor_ + 1, composing_.size()));
+            break;
+        }
+        case hazkey::RequestEnvelope::kGetCandidates: {
+            std::string text = joinChars(composing_, 0, composing_.size());
+            int count = request.get_candidates().is_suggest()
+                            ? NUM_SUGGESTIONS
+                            : NUM_CANDIDATES;
+            auto* candidates = response.mutable_candidates();
+            for (int i = 0; i < count; ++i) {
+                auto* candidate = candidates->add_candidates();
+                candidate->set_text(i == 0 ? text
+                                           : text + "#" + std::to_string(i));
+            }
+            candidates->set_live_text(text);
+            candidates->set_live_text_index(0);
+            candidates->set_page_size(NUM_CANDIDATES);
+            break;
+        }
+        case hazkey::RequestEnvelope::kGetLiveText: {
+            auto* candidates = response.mutable_candidates();
+            candidates->set_live_text(
+                joinChars(composing_, 0, composing_.size()));
+            candidates->set_live_text_index(0);
+            candidates->set_page_size(NUM_CANDIDATES);
+            break;
+        }
+        case hazkey::RequestEnvelope::kGetCurrentInputMode:
+            response.mutable_current_input_mode_info()->set_input_mode(
+                hazkey::commands::CurrentInputModeInfo::NORMAL);
+            break;
+        case hazkey::RequestEnvelope::kGetServerStatus:
+            response.mutable_server_status()->set_warm_up_state(
+                hazkey::commands::ServerStatus::READY);
+            break;
+        default:
+            break;
+    }
+    return response;
+}
@@ -0,0 +1,61 @@
+#ifndef _FCITX5_HAZKEY_TOOLS_MOCK_SERVER_H_
+#define _FCITX5_HAZKEY_TOOLS_MOCK_SERVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base.pb.h"
+
+// Stand-in for hazkey-server that speaks the same socket protocol and answers
+// with deterministic data. Composing text is kept as typed (no kana
+// conversion) and candidates are derived from it.
+class MockServer {
+   public:
+    // scripted misbehaviour, for testing the connector
+    struct Behavior {
+        // delay before every response
+        std::chrono::milliseconds delay{0};
+        // per-command delay, replacing `delay`
+        std::map<hazkey::RequestEnvelope::PayloadCase, std::chrono::milliseconds>
+            commandDelays;
+        // close the connection instead of answering every Nth request
+        int dropEvery = 0;
+        // answer every Nth request with a length above the client's limit
+        int oversizeEvery = 0;
+    };
+
+    explicit MockServer(std::string socketPath);
+    MockServer(std::string socketPath, Behavior behavior);
+    ~MockServer();
+
+    // bind the socket and start serving on a background thread
+    bool start();
+    void stop();
+
+    uint64_t requestCount() const { return requestCount_; }
+
+    hazkey::ResponseEnvelope handle(const hazkey::RequestEnvelope& request);
+
+   private:
+    void serve();
+    void serveClient(int fd);
+
+    std::string socketPath_;
+    Behavior behavior_;
+    int listenFd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_ = false;
+    std::atomic<uint64_t> requestCount_ = 0;
+
+    // composing characters (UTF-8 each) and cursor, only touched by the
+    // server thread
+    std::vector<std::string> composing_;
+    size_t cursor_ = 0;
+};
+
+#endif  // _FCITX5_HAZKEY_TOOLS_MOCK_SERVER_H_
@@ -0,0 +1,105 @@
+// Standalone mock hazkey-server for testing the addon and its connector.
+//
+// usage: hazkey-mock-server [--socket PATH] [--delay MS]
+//                           [--command-delay COMMAND=MS] [--drop-every N]
+//                           [--oversize-every N]
+
+#include <signal.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "hazkey_socket_path.h"
+#include "mock_server.h"
+
+namespace {
+
+const std::map<std::string, hazkey::RequestEnvelope::PayloadCase>
+    COMMAND_NAMES = {
+        {"new_composing_text", hazkey::RequestEnvelope::kNewComposingText},
+        {"set_context", hazkey::RequestEnvelope::kSetContext},
+        {"input_char", hazkey::RequestEnvelope::kInputChar},
+        {"modifier_event", hazkey::RequestEnvelope::kModifierEvent},
+        {"move_cursor", hazkey::RequestEnvelope::kMoveCursor},
+        {"prefix_complete", hazkey::RequestEnvelope::kPrefixComplete},
+        {"delete_left", hazkey::RequestEnvelope::kDeleteLeft},
+        {"delete_right", hazkey::RequestEnvelope::kDeleteRight},
+        {"get_composing_string", hazkey::RequestEnvelope::kGetComposingString},
+        {"get_hiragana_with_cursor",
+         hazkey::RequestEnvelope::kGetHiraganaWithCursor},
+        {"get_candidates", hazkey::RequestEnvelope::kGetCandidates},
+        {"get_live_text", hazkey::RequestEnvelope::kGetLiveText},
+        {"get_current_input_mode",
+         hazkey::RequestEnvelope::kGetCurrentInputMode},
+        {"save_learning_data", hazkey::RequestEnvelope::kSaveLearningData},
+        {"get_server_status", hazkey::RequestEnvelope::kGetServerStatus},
+};
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program
+              << " [--socket PATH] [--delay MS] [--command-delay COMMAND=MS]"
+                 " [--drop-every N] [--oversize-every N]"
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string socketPath = hazkeySocketPath();
+    MockServer::Behavior behavior;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--socket") {
+            socketPath = value;
+        } else if (arg == "--delay") {
+            behavior.delay =
+                std::chrono::milliseconds(std::atoi(value.c_str()));
+        } else if (arg == "--command-delay") {
+            auto separator = value.find('=');
+            auto command = COMMAND_NAMES.find(value.substr(0, separator));
+            if (separator == std::string::npos ||
+                command == COMMAND_NAMES.end()) {
+                std::cerr << "Unknown command delay: " << value << std::endl;
+                return 1;
+            }
+            behavior.commandDelays[command->second] = std::chrono::milliseconds(
+                std::atoi(value.c_str() + separator + 1));
+        } else if (arg == "--drop-every") {
+            behavior.dropEvery = std::atoi(value.c_str());
+        } else if (arg == "--oversize-every") {
+            behavior.oversizeEvery = std::atoi(value.c_str());
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // handled by sigwait below; blocked before the server thread starts so
+    // that it inherits the mask
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    MockServer server(socketPath, behavior);
+    if (!server.start()) {
+        return 1;
+    }
+    std::cerr << "mock hazkey-server listening on " << socketPath << std::endl;
+
+    int received;
+    sigwait(&signals, &received);
+
+    server.stop();
+    std::cerr << "served " << server.requestCount() << " requests" << std::endl;
+    return 0;
+}
@@ -9,7 +9,12 @@ let package = Package(
         // Products define the executables and libraries a package produces, making them visible to other packages.
         .executable(
             name: "hazkey-server",
-            targets: ["hazkey-server"])
+            targets: ["hazkey-server"]),
+        // Converter core with a C ABI, loaded by fcitx5-hazkey in in-process mode
+        .library(
+            name: "hazkey-core",
+            type: .dynamic,
+            targets: ["HazkeyCore"]),
     ],
     traits: [
         "ZenzaiSupport"
@@ -24,8 +29,8 @@ let package = Package(
     targets: [
         // Targets are the basic building blocks of a package, defining a module or a test suite.
         // Targets can depend on other targets in this package and products from dependencies.
-        .executableTarget(
-            name: "hazkey-server",
+        .target(
+            name: "HazkeyCore",
             dependencies: [
                 .product(
                     name: "KanaKanjiConverterModule",
@@ -35,17 +40,37 @@ let package = Package(
                     package: "AzooKeyKanaKanjiConverter"),
                 .product(name: "SwiftProtobuf", package: "swift-protobuf"),
             ],
+            path: "Sources/hazkey-server",
+            exclude: ["constants.swift.in"],
+            swiftSettings: [.interoperabilityMode(.Cxx)],
+            linkerSettings: [
+                .unsafeFlags(["-Xlinker", "-rpath", "-Xlinker", "$ORIGIN/libllama"])
+            ],
+        ),
+        .executableTarget(
+            name: "hazkey-server",
+            dependencies: ["HazkeyCore"],
+            path: "Sources/hazkey-server-main",
             swiftSettings: [.interoperabilityMode(.Cxx)],
             linkerSettings: [
                 .unsafeFlags(["-Xlinker", "-rpath", "-Xlinker", "$ORIGIN/libllama"])
             ],
         ),
+        // Unit tests of HazkeyCore
+        .testTarget(
+            name: "hazkey-core-tests",
+            dependencies: ["HazkeyCore"],
+            path: "Tests/hazkey-core",
+            swiftSettings: [.interoperabilityMode(.Cxx)],
+        ),
+        // Integration tests; they talk to a running hazkey-server
         .testTarget(
             name: "hazkey-server-tests",
             dependencies: [
-                "hazkey-server",
+                "HazkeyCore",
                 .product(name: "SwiftProtobuf", package: "swift-protobuf"),
             ],
+            path: "Tests/hazkey-server",
             swiftSettings: [.interoperabilityMode(.Cxx)],
         ),
     ]
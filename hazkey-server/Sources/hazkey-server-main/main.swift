@@ -1,6 +1,6 @@
 import Dispatch
 import Foundation
-import KanaKanjiConverterModule
+import HazkeyCore
 
 do {
     NSLog("Starting hazkey-server...")
@@ -169,6 +169,62 @@ struct Hazkey_RequestEnvelope: Sendable {
     set {payload = .saveLearningData(newValue)}
   }
 
+  var getServerStatus: Hazkey_Commands_GetServerStatus {
+    get {
+      if case .getServerStatus(let v)? = payload {return v}
+      return Hazkey_Commands_GetServerStatus()
+    }
+    set {payload = .getServerStatus(newValue)}
+  }
+
+  var getStats: Hazkey_Commands_GetStats {
+    get {
+      if case .getStats(let v)? = payload {return v}
+      return Hazkey_Commands_GetStats()
+    }
+    set {payload = .getStats(newValue)}
+  }
+
+  var convertBatch: Hazkey_Commands_ConvertBatch {
+    get {
+      if case .convertBatch(let v)? = payload {return v}
+      return Hazkey_Commands_ConvertBatch()
+    }
+    set {payload = .convertBatch(newValue)}
+  }
+
+  var runBenchmark: Hazkey_Commands_RunBenchmark {
+    get {
+      if case .runBenchmark(let v)? = payload {return v}
+      return Hazkey_Commands_RunBenchmark()
+    }
+    set {payload = .runBenchmark(newValue)}
+  }
+
+  var hello: Hazkey_Commands_Hello {
+    get {
+      if case .hello(let v)? = payload {return v}
+      return Hazkey_Commands_Hello()
+    }
+    set {payload = .hello(newValue)}
+  }
+
+  var getLiveText: Hazkey_Commands_GetLiveText {
+    get {
+      if case .getLiveText(let v)? = payload {return v}
+      return Hazkey_Commands_GetLiveText()
+    }
+    set {payload = .getLiveText(newValue)}
+  }
+
+  var getComposingVariants: Hazkey_Commands_GetComposingVariants {
+    get {
+      if case .getComposingVariants(let v)? = payload {return v}
+      return Hazkey_Commands_GetComposingVariants()
+    }
+    set {payload = .getComposingVariants(newValue)}
+  }
+
   var getConfig: Hazkey_Config_GetConfig {
     get {
       if case .getConfig(let v)? = payload {return v}
@@ -209,6 +265,8 @@ struct Hazkey_RequestEnvelope: Sendable {
     set {payload = .reloadZenzaiModel(newValue)}
   }
 
+  var traceID: UInt64 = 0
+
   var unknownFields = SwiftProtobuf.UnknownStorage()
 
   enum OneOf_Payload: Equatable, Sendable {
@@ -225,6 +283,13 @@ struct Hazkey_RequestEnvelope: Sendable {
     case getCandidates(Hazkey_Commands_GetCandidates)
     case getCurrentInputMode(Hazkey_Commands_GetCurrentInputModeInfo)
     case saveLearningData(Hazkey_Commands_SaveLearningData)
+    case getServerStatus(Hazkey_Commands_GetServerStatus)
+    case getStats(Hazkey_Commands_GetStats)
+    case convertBatch(Hazkey_Commands_ConvertBatch)
+    case runBenchmark(Hazkey_Commands_RunBenchmark)
+    case hello(Hazkey_Commands_Hello)
+    case getLiveText(Hazkey_Commands_GetLiveText)
+    case getComposingVariants(Hazkey_Commands_GetComposingVariants)
     case getConfig(Hazkey_Config_GetConfig)
     case setConfig(Hazkey_Config_SetConfig)
     case getDefaultProfile(Hazkey_Config_GetDefaultProfile)
@@ -279,6 +344,54 @@ struct Hazkey_ResponseEnvelope: Sendable {
     set {payload = .currentInputModeInfo(newValue)}
   }
 
+  var serverStatus: Hazkey_Commands_ServerStatus {
+    get {
+      if case .serverStatus(let v)? = payload {return v}
+      return Hazkey_Commands_ServerStatus()
+    }
+    set {payload = .serverStatus(newValue)}
+  }
+
+  var stats: Hazkey_Commands_ServerStats {
+    get {
+      if case .stats(let v)? = payload {return v}
+      return Hazkey_Commands_ServerStats()
+    }
+    set {payload = .stats(newValue)}
+  }
+
+  var batchResult: Hazkey_Commands_BatchResult {
+    get {
+      if case .batchResult(let v)? = payload {return v}
+      return Hazkey_Commands_BatchResult()
+    }
+    set {payload = .batchResult(newValue)}
+  }
+
+  var benchmarkResult: Hazkey_Commands_BenchmarkResult {
+    get {
+      if case .benchmarkResult(let v)? = payload {return v}
+      return Hazkey_Commands_BenchmarkResult()
+    }
+    set {payload = .benchmarkResult(newValue)}
+  }
+
+  var helloResult: Hazkey_Commands_HelloResult {
+    get {
+      if case .helloResult(let v)? = payload {return v}
+      return Hazkey_Commands_HelloResult()
+    }
+    set {payload = .helloResult(newValue)}
+  }
+
+  var composingVariants: Hazkey_Commands_ComposingVariants {
+    get {
+      if case .composingVariants(let v)? = payload {return v}
+      return Hazkey_Commands_ComposingVariants()
+    }
+    set {payload = .composingVariants(newValue)}
+  }
+
   var currentConfig: Hazkey_Config_CurrentConfig {
     get {
       if case .currentConfig(let v)? = payload {return v}
@@ -294,6 +407,12 @@ struct Hazkey_ResponseEnvelope: Sendable {
     case candidates(Hazkey_Commands_CandidatesResult)
     case textWithCursor(Hazkey_Commands_TextWithCursor)
     case currentInputModeInfo(Hazkey_Commands_CurrentInputModeInfo)
+    case serverStatus(Hazkey_Commands_ServerStatus)
+    case stats(Hazkey_Commands_ServerStats)
+    case batchResult(Hazkey_Commands_BatchResult)
+    case benchmarkResult(Hazkey_Commands_BenchmarkResult)
+    case helloResult(Hazkey_Commands_HelloResult)
+    case composingVariants(Hazkey_Commands_ComposingVariants)
     case currentConfig(Hazkey_Config_CurrentConfig)
 
   }
@@ -329,11 +448,19 @@ extension Hazkey_RequestEnvelope: SwiftProtobuf.Message, SwiftProtobuf._MessageI
     11: .standard(proto: "get_candidates"),
     12: .standard(proto: "get_current_input_mode"),
     13: .standard(proto: "save_learning_data"),
+    14: .standard(proto: "get_server_status"),
+    15: .standard(proto: "get_stats"),
+    16: .standard(proto: "convert_batch"),
+    17: .standard(proto: "run_benchmark"),
+    18: .same(proto: "hello"),
+    19: .standard(proto: "get_live_text"),
+    20: .standard(proto: "get_composing_variants"),
     100: .standard(proto: "get_config"),
     101: .standard(proto: "set_config"),
     102: .standard(proto: "get_default_profile"),
     103: .standard(proto: "clear_all_history"),
     104: .standard(proto: "reload_zenzai_model"),
+    200: .standard(proto: "trace_id"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -511,6 +638,97 @@ extension Hazkey_RequestEnvelope: SwiftProtobuf.Message, SwiftProtobuf._MessageI
           self.payload = .saveLearningData(v)
         }
       }()
+      case 14: try {
+        var v: Hazkey_Commands_GetServerStatus?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .getServerStatus(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .getServerStatus(v)
+        }
+      }()
+      case 15: try {
+        var v: Hazkey_Commands_GetStats?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .getStats(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .getStats(v)
+        }
+      }()
+      case 16: try {
+        var v: Hazkey_Commands_ConvertBatch?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .convertBatch(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .convertBatch(v)
+        }
+      }()
+      case 17: try {
+        var v: Hazkey_Commands_RunBenchmark?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .runBenchmark(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .runBenchmark(v)
+        }
+      }()
+      case 18: try {
+        var v: Hazkey_Commands_Hello?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .hello(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .hello(v)
+        }
+      }()
+      case 19: try {
+        var v: Hazkey_Commands_GetLiveText?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .getLiveText(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .getLiveText(v)
+        }
+      }()
+      case 20: try {
+        var v: Hazkey_Commands_GetComposingVariants?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .getComposingVariants(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .getComposingVariants(v)
+        }
+      }()
       case 100: try {
         var v: Hazkey_Config_GetConfig?
         var hadOneofValue = false
@@ -576,6 +794,7 @@ extension Hazkey_RequestEnvelope: SwiftProtobuf.Message, SwiftProtobuf._MessageI
           self.payload = .reloadZenzaiModel(v)
         }
       }()
+      case 200: try { try decoder.decodeSingularUInt64Field(value: &self.traceID) }()
       default: break
       }
     }
@@ -639,6 +858,34 @@ extension Hazkey_RequestEnvelope: SwiftProtobuf.Message, SwiftProtobuf._MessageI
       guard case .saveLearningData(let v)? = self.payload else { preconditionFailure() }
       try visitor.visitSingularMessageField(value: v, fieldNumber: 13)
     }()
+    case .getServerStatus?: try {
+      guard case .getServerStatus(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 14)
+    }()
+    case .getStats?: try {
+      guard case .getStats(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 15)
+    }()
+    case .convertBatch?: try {
+      guard case .convertBatch(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 16)
+    }()
+    case .runBenchmark?: try {
+      guard case .runBenchmark(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 17)
+    }()
+    case .hello?: try {
+      guard case .hello(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 18)
+    }()
+    case .getLiveText?: try {
+      guard case .getLiveText(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 19)
+    }()
+    case .getComposingVariants?: try {
+      guard case .getComposingVariants(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 20)
+    }()
     case .getConfig?: try {
       guard case .getConfig(let v)? = self.payload else { preconditionFailure() }
       try visitor.visitSingularMessageField(value: v, fieldNumber: 100)
@@ -661,11 +908,15 @@ extension Hazkey_RequestEnvelope: SwiftProtobuf.Message, SwiftProtobuf._MessageI
     }()
     case nil: break
     }
+    if self.traceID != 0 {
+      try visitor.visitSingularUInt64Field(value: self.traceID, fieldNumber: 200)
+    }
     try unknownFields.traverse(visitor: &visitor)
   }
 
   static func ==(lhs: Hazkey_RequestEnvelope, rhs: Hazkey_RequestEnvelope) -> Bool {
     if lhs.payload != rhs.payload {return false}
+    if lhs.traceID != rhs.traceID {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
@@ -680,6 +931,12 @@ extension Hazkey_ResponseEnvelope: SwiftProtobuf.Message, SwiftProtobuf._Message
     4: .same(proto: "candidates"),
     5: .standard(proto: "text_with_cursor"),
     6: .standard(proto: "current_input_mode_info"),
+    7: .standard(proto: "server_status"),
+    8: .same(proto: "stats"),
+    9: .standard(proto: "batch_result"),
+    10: .standard(proto: "benchmark_result"),
+    11: .standard(proto: "hello_result"),
+    12: .standard(proto: "composing_variants"),
     100: .standard(proto: "current_config"),
   ]
 
@@ -738,6 +995,84 @@ extension Hazkey_ResponseEnvelope: SwiftProtobuf.Message, SwiftProtobuf._Message
           self.payload = .currentInputModeInfo(v)
         }
       }()
+      case 7: try {
+        var v: Hazkey_Commands_ServerStatus?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .serverStatus(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .serverStatus(v)
+        }
+      }()
+      case 8: try {
+        var v: Hazkey_Commands_ServerStats?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .stats(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .stats(v)
+        }
+      }()
+      case 9: try {
+        var v: Hazkey_Commands_BatchResult?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .batchResult(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .batchResult(v)
+        }
+      }()
+      case 10: try {
+        var v: Hazkey_Commands_BenchmarkResult?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .benchmarkResult(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .benchmarkResult(v)
+        }
+      }()
+      case 11: try {
+        var v: Hazkey_Commands_HelloResult?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .helloResult(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .helloResult(v)
+        }
+      }()
+      case 12: try {
+        var v: Hazkey_Commands_ComposingVariants?
+        var hadOneofValue = false
+        if let current = self.payload {
+          hadOneofValue = true
+          if case .composingVariants(let m) = current {v = m}
+        }
+        try decoder.decodeSingularMessageField(value: &v)
+        if let v = v {
+          if hadOneofValue {try decoder.handleConflictingOneOf()}
+          self.payload = .composingVariants(v)
+        }
+      }()
       case 100: try {
         var v: Hazkey_Config_CurrentConfig?
         var hadOneofValue = false
@@ -784,6 +1119,30 @@ extension Hazkey_ResponseEnvelope: SwiftProtobuf.Message, SwiftProtobuf._Message
       guard case .currentInputModeInfo(let v)? = self.payload else { preconditionFailure() }
       try visitor.visitSingularMessageField(value: v, fieldNumber: 6)
     }()
+    case .serverStatus?: try {
+      guard case .serverStatus(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 7)
+    }()
+    case .stats?: try {
+      guard case .stats(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 8)
+    }()
+    case .batchResult?: try {
+      guard case .batchResult(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 9)
+    }()
+    case .benchmarkResult?: try {
+      guard case .benchmarkResult(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 10)
+    }()
+    case .helloResult?: try {
+      guard case .helloResult(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 11)
+    }()
+    case .composingVariants?: try {
+      guard case .composingVariants(let v)? = self.payload else { preconditionFailure() }
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 12)
+    }()
     case .currentConfig?: try {
       guard case .currentConfig(let v)? = self.payload else { preconditionFailure() }
       try visitor.visitSingularMessageField(value: v, fieldNumber: 100)
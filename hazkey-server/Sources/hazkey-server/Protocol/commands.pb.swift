@@ -20,6 +20,76 @@ fileprivate struct _GeneratedWithProtocGenSwiftVersion: SwiftProtobuf.ProtobufAP
   typealias Version = _2
 }
 
+struct Hazkey_Commands_Hello: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var protocolVersion: UInt32 = 0
+
+  var features: UInt64 = 0
+
+  var version: String = String()
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  enum Feature: SwiftProtobuf.Enum, Swift.CaseIterable {
+    typealias RawValue = Int
+    case unspecified // = 0
+    case batch // = 1
+    case benchmark // = 8
+    case compactCandidates // = 16
+    case liveText // = 32
+    case composingVariants // = 64
+    case clientSubInput // = 128
+    case UNRECOGNIZED(Int)
+
+    init() {
+      self = .unspecified
+    }
+
+    init?(rawValue: Int) {
+      switch rawValue {
+      case 0: self = .unspecified
+      case 1: self = .batch
+      case 8: self = .benchmark
+      case 16: self = .compactCandidates
+      case 32: self = .liveText
+      case 64: self = .composingVariants
+      case 128: self = .clientSubInput
+      default: self = .UNRECOGNIZED(rawValue)
+      }
+    }
+
+    var rawValue: Int {
+      switch self {
+      case .unspecified: return 0
+      case .batch: return 1
+      case .benchmark: return 8
+      case .compactCandidates: return 16
+      case .liveText: return 32
+      case .composingVariants: return 64
+      case .clientSubInput: return 128
+      case .UNRECOGNIZED(let i): return i
+      }
+    }
+
+    // The compiler won't synthesize support with the UNRECOGNIZED case.
+    static let allCases: [Hazkey_Commands_Hello.Feature] = [
+      .unspecified,
+      .batch,
+      .benchmark,
+      .compactCandidates,
+      .liveText,
+      .composingVariants,
+      .clientSubInput,
+    ]
+
+  }
+
+  init() {}
+}
+
 struct Hazkey_Commands_NewComposingText: Sendable {
   // SwiftProtobuf.Message conformance is added in an extension below. See the
   // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
@@ -39,6 +109,8 @@ struct Hazkey_Commands_SetContext: Sendable {
 
   var anchor: Int32 = 0
 
+  var windowLength: Int32 = 0
+
   var unknownFields = SwiftProtobuf.UnknownStorage()
 
   init() {}
@@ -51,6 +123,8 @@ struct Hazkey_Commands_InputChar: Sendable {
 
   var text: String = String()
 
+  var direct: Bool = false
+
   var unknownFields = SwiftProtobuf.UnknownStorage()
 
   init() {}
@@ -246,6 +320,16 @@ struct Hazkey_Commands_GetComposingString: Sendable {
   init() {}
 }
 
+struct Hazkey_Commands_GetComposingVariants: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  init() {}
+}
+
 struct Hazkey_Commands_GetHiraganaWithCursor: Sendable {
   // SwiftProtobuf.Message conformance is added in an extension below. See the
   // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
@@ -268,6 +352,16 @@ struct Hazkey_Commands_GetCandidates: Sendable {
   init() {}
 }
 
+struct Hazkey_Commands_GetLiveText: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  init() {}
+}
+
 struct Hazkey_Commands_GetCurrentInputModeInfo: Sendable {
   // SwiftProtobuf.Message conformance is added in an extension below. See the
   // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
@@ -288,6 +382,95 @@ struct Hazkey_Commands_SaveLearningData: Sendable {
   init() {}
 }
 
+struct Hazkey_Commands_GetServerStatus: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  init() {}
+}
+
+struct Hazkey_Commands_GetStats: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  init() {}
+}
+
+struct Hazkey_Commands_ConvertBatch: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var inputs: [String] = []
+
+  var nBest: Int32 = 0
+
+  var workers: Int32 = 0
+
+  var leftContexts: [String] = []
+
+  var useProfile: Bool = false
+
+  var profile: Hazkey_Config_Profile {
+    get {return _profile ?? Hazkey_Config_Profile()}
+    set {_profile = newValue}
+  }
+  /// Returns true if `profile` has been explicitly set.
+  var hasProfile: Bool {return self._profile != nil}
+  /// Clears the value of `profile`. Subsequent reads from it will return its default value.
+  mutating func clearProfile() {self._profile = nil}
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  init() {}
+
+  fileprivate var _profile: Hazkey_Config_Profile? = nil
+}
+
+struct Hazkey_Commands_RunBenchmark: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var settings: [Hazkey_Commands_RunBenchmark.Setting] = []
+
+  var iterations: Int32 = 0
+
+  var firstSample: Int32 = 0
+
+  var sampleCount: Int32 = 0
+
+  var warmUp: Bool = false
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  struct Setting: Sendable {
+    // SwiftProtobuf.Message conformance is added in an extension below. See the
+    // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+    // methods supported on all messages.
+
+    var zenzaiEnable: Bool = false
+
+    var zenzaiInferLimit: Int32 = 0
+
+    var zenzaiBackendDeviceName: String = String()
+
+    var zenzaiContextualMode: Bool = false
+
+    var unknownFields = SwiftProtobuf.UnknownStorage()
+
+    init() {}
+  }
+
+  init() {}
+}
+
 struct Hazkey_Commands_Text: Sendable {
   // SwiftProtobuf.Message conformance is added in an extension below. See the
   // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
@@ -316,6 +499,26 @@ struct Hazkey_Commands_TextWithCursor: Sendable {
   init() {}
 }
 
+struct Hazkey_Commands_ComposingVariants: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var hiragana: String = String()
+
+  var katakanaFull: String = String()
+
+  var katakanaHalf: String = String()
+
+  var alphabetFull: [String] = []
+
+  var alphabetHalf: [String] = []
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  init() {}
+}
+
 struct Hazkey_Commands_CandidatesResult: Sendable {
   // SwiftProtobuf.Message conformance is added in an extension below. See the
   // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
@@ -329,6 +532,10 @@ struct Hazkey_Commands_CandidatesResult: Sendable {
 
   var pageSize: Int32 = 0
 
+  var warmingUp: Bool = false
+
+  var reading: String = String()
+
   var unknownFields = SwiftProtobuf.UnknownStorage()
 
   struct Candidate: Sendable {
@@ -340,6 +547,8 @@ struct Hazkey_Commands_CandidatesResult: Sendable {
 
     var subHiragana: String = String()
 
+    var consumedBytes: Int32 = 0
+
     var unknownFields = SwiftProtobuf.UnknownStorage()
 
     init() {}
@@ -394,115 +603,391 @@ struct Hazkey_Commands_CurrentInputModeInfo: Sendable {
   init() {}
 }
 
-// MARK: - Code below here is support for the SwiftProtobuf runtime.
+struct Hazkey_Commands_ServerStatus: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
 
-fileprivate let _protobuf_package = "hazkey.commands"
+  var warmUpState: Hazkey_Commands_ServerStatus.WarmUpState = .unspecified
 
-extension Hazkey_Commands_NewComposingText: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".NewComposingText"
-  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+  var zenzaiLoaded: Bool = false
 
-  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    // Load everything into unknown fields
-    while try decoder.nextFieldNumber() != nil {}
-  }
+  var warmUpTimeMs: Int64 = 0
 
-  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    try unknownFields.traverse(visitor: &visitor)
-  }
+  var unknownFields = SwiftProtobuf.UnknownStorage()
 
-  static func ==(lhs: Hazkey_Commands_NewComposingText, rhs: Hazkey_Commands_NewComposingText) -> Bool {
-    if lhs.unknownFields != rhs.unknownFields {return false}
-    return true
-  }
-}
+  enum WarmUpState: SwiftProtobuf.Enum, Swift.CaseIterable {
+    typealias RawValue = Int
+    case unspecified // = 0
+    case warmingUp // = 1
+    case ready // = 2
+    case disabled // = 3
+    case UNRECOGNIZED(Int)
 
-extension Hazkey_Commands_SetContext: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".SetContext"
-  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .same(proto: "context"),
-    2: .same(proto: "anchor"),
-  ]
+    init() {
+      self = .unspecified
+    }
 
-  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    while let fieldNumber = try decoder.nextFieldNumber() {
-      // The use of inline closures is to circumvent an issue where the compiler
-      // allocates stack space for every case branch when no optimizations are
-      // enabled. https://github.com/apple/swift-protobuf/issues/1034
-      switch fieldNumber {
-      case 1: try { try decoder.decodeSingularStringField(value: &self.context) }()
-      case 2: try { try decoder.decodeSingularInt32Field(value: &self.anchor) }()
-      default: break
+    init?(rawValue: Int) {
+      switch rawValue {
+      case 0: self = .unspecified
+      case 1: self = .warmingUp
+      case 2: self = .ready
+      case 3: self = .disabled
+      default: self = .UNRECOGNIZED(rawValue)
       }
     }
-  }
 
-  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if !self.context.isEmpty {
-      try visitor.visitSingularStringField(value: self.context, fieldNumber: 1)
-    }
-    if self.anchor != 0 {
-      try visitor.visitSingularInt32Field(value: self.anchor, fieldNumber: 2)
+    var rawValue: Int {
+      switch self {
+      case .unspecified: return 0
+      case .warmingUp: return 1
+      case .ready: return 2
+      case .disabled: return 3
+      case .UNRECOGNIZED(let i): return i
+      }
     }
-    try unknownFields.traverse(visitor: &visitor)
-  }
 
-  static func ==(lhs: Hazkey_Commands_SetContext, rhs: Hazkey_Commands_SetContext) -> Bool {
-    if lhs.context != rhs.context {return false}
-    if lhs.anchor != rhs.anchor {return false}
-    if lhs.unknownFields != rhs.unknownFields {return false}
-    return true
+    // The compiler won't synthesize support with the UNRECOGNIZED case.
+    static let allCases: [Hazkey_Commands_ServerStatus.WarmUpState] = [
+      .unspecified,
+      .warmingUp,
+      .ready,
+      .disabled,
+    ]
+
   }
+
+  init() {}
 }
 
-extension Hazkey_Commands_InputChar: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".InputChar"
-  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .same(proto: "text"),
-  ]
+struct Hazkey_Commands_ServerStats: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
 
-  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    while let fieldNumber = try decoder.nextFieldNumber() {
-      // The use of inline closures is to circumvent an issue where the compiler
-      // allocates stack space for every case branch when no optimizations are
-      // enabled. https://github.com/apple/swift-protobuf/issues/1034
-      switch fieldNumber {
-      case 1: try { try decoder.decodeSingularStringField(value: &self.text) }()
-      default: break
-      }
-    }
-  }
+  var commands: [Hazkey_Commands_ServerStats.CommandStats] = []
 
-  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if !self.text.isEmpty {
-      try visitor.visitSingularStringField(value: self.text, fieldNumber: 1)
-    }
-    try unknownFields.traverse(visitor: &visitor)
-  }
+  var histogramBoundsUs: [Int64] = []
 
-  static func ==(lhs: Hazkey_Commands_InputChar, rhs: Hazkey_Commands_InputChar) -> Bool {
-    if lhs.text != rhs.text {return false}
-    if lhs.unknownFields != rhs.unknownFields {return false}
-    return true
-  }
-}
+  var latticeConversions: Int64 = 0
 
-extension Hazkey_Commands_ModifierEvent: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".ModifierEvent"
-  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .standard(proto: "mod_type"),
-    2: .standard(proto: "event_type"),
-  ]
+  var latticeTimeUs: Int64 = 0
 
-  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    while let fieldNumber = try decoder.nextFieldNumber() {
-      // The use of inline closures is to circumvent an issue where the compiler
-      // allocates stack space for every case branch when no optimizations are
-      // enabled. https://github.com/apple/swift-protobuf/issues/1034
-      switch fieldNumber {
-      case 1: try { try decoder.decodeSingularEnumField(value: &self.modType) }()
-      case 2: try { try decoder.decodeSingularEnumField(value: &self.eventType) }()
-      default: break
+  var zenzaiConversions: Int64 = 0
+
+  var zenzaiTimeUs: Int64 = 0
+
+  var caches: [Hazkey_Commands_ServerStats.CacheStats] = []
+
+  var learningDataBytes: Int64 = 0
+
+  var rssBytes: Int64 = 0
+
+  var zenzaiAvailable: Bool = false
+
+  var zenzaiLoaded: Bool = false
+
+  var uptimeMs: Int64 = 0
+
+  var configSaveError: String = String()
+
+  var inProcess: Bool = false
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  struct CommandStats: Sendable {
+    // SwiftProtobuf.Message conformance is added in an extension below. See the
+    // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+    // methods supported on all messages.
+
+    var command: String = String()
+
+    var count: Int64 = 0
+
+    var totalUs: Int64 = 0
+
+    var maxUs: Int64 = 0
+
+    var histogram: [Int64] = []
+
+    var unknownFields = SwiftProtobuf.UnknownStorage()
+
+    init() {}
+  }
+
+  struct CacheStats: Sendable {
+    // SwiftProtobuf.Message conformance is added in an extension below. See the
+    // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+    // methods supported on all messages.
+
+    var name: String = String()
+
+    var hits: Int64 = 0
+
+    var lookups: Int64 = 0
+
+    var unknownFields = SwiftProtobuf.UnknownStorage()
+
+    init() {}
+  }
+
+  init() {}
+}
+
+struct Hazkey_Commands_BatchResult: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var items: [Hazkey_Commands_BatchResult.Item] = []
+
+  var workers: Int32 = 0
+
+  var elapsedUs: Int64 = 0
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  struct Item: Sendable {
+    // SwiftProtobuf.Message conformance is added in an extension below. See the
+    // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+    // methods supported on all messages.
+
+    var candidates: [String] = []
+
+    var latencyUs: Int64 = 0
+
+    var unknownFields = SwiftProtobuf.UnknownStorage()
+
+    init() {}
+  }
+
+  init() {}
+}
+
+struct Hazkey_Commands_BenchmarkResult: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var settings: [Hazkey_Commands_BenchmarkResult.Setting] = []
+
+  var sampleSetSize: Int32 = 0
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  struct Setting: Sendable {
+    // SwiftProtobuf.Message conformance is added in an extension below. See the
+    // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+    // methods supported on all messages.
+
+    var zenzaiUsed: Bool = false
+
+    var latenciesUs: [Int64] = []
+
+    var unknownFields = SwiftProtobuf.UnknownStorage()
+
+    init() {}
+  }
+
+  init() {}
+}
+
+struct Hazkey_Commands_HelloResult: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  var protocolVersion: UInt32 = 0
+
+  var features: UInt64 = 0
+
+  var version: String = String()
+
+  var submodeEntryPointChars: String = String()
+
+  var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  init() {}
+}
+
+// MARK: - Code below here is support for the SwiftProtobuf runtime.
+
+fileprivate let _protobuf_package = "hazkey.commands"
+
+extension Hazkey_Commands_Hello: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".Hello"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .standard(proto: "protocol_version"),
+    2: .same(proto: "features"),
+    3: .same(proto: "version"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularUInt32Field(value: &self.protocolVersion) }()
+      case 2: try { try decoder.decodeSingularUInt64Field(value: &self.features) }()
+      case 3: try { try decoder.decodeSingularStringField(value: &self.version) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if self.protocolVersion != 0 {
+      try visitor.visitSingularUInt32Field(value: self.protocolVersion, fieldNumber: 1)
+    }
+    if self.features != 0 {
+      try visitor.visitSingularUInt64Field(value: self.features, fieldNumber: 2)
+    }
+    if !self.version.isEmpty {
+      try visitor.visitSingularStringField(value: self.version, fieldNumber: 3)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_Hello, rhs: Hazkey_Commands_Hello) -> Bool {
+    if lhs.protocolVersion != rhs.protocolVersion {return false}
+    if lhs.features != rhs.features {return false}
+    if lhs.version != rhs.version {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_Hello.Feature: SwiftProtobuf._ProtoNameProviding {
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    0: .same(proto: "FEATURE_UNSPECIFIED"),
+    1: .same(proto: "FEATURE_BATCH"),
+    8: .same(proto: "FEATURE_BENCHMARK"),
+    16: .same(proto: "FEATURE_COMPACT_CANDIDATES"),
+    32: .same(proto: "FEATURE_LIVE_TEXT"),
+    64: .same(proto: "FEATURE_COMPOSING_VARIANTS"),
+    128: .same(proto: "FEATURE_CLIENT_SUB_INPUT"),
+  ]
+}
+
+extension Hazkey_Commands_NewComposingText: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".NewComposingText"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_NewComposingText, rhs: Hazkey_Commands_NewComposingText) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_SetContext: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".SetContext"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "context"),
+    2: .same(proto: "anchor"),
+    3: .standard(proto: "window_length"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.context) }()
+      case 2: try { try decoder.decodeSingularInt32Field(value: &self.anchor) }()
+      case 3: try { try decoder.decodeSingularInt32Field(value: &self.windowLength) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.context.isEmpty {
+      try visitor.visitSingularStringField(value: self.context, fieldNumber: 1)
+    }
+    if self.anchor != 0 {
+      try visitor.visitSingularInt32Field(value: self.anchor, fieldNumber: 2)
+    }
+    if self.windowLength != 0 {
+      try visitor.visitSingularInt32Field(value: self.windowLength, fieldNumber: 3)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_SetContext, rhs: Hazkey_Commands_SetContext) -> Bool {
+    if lhs.context != rhs.context {return false}
+    if lhs.anchor != rhs.anchor {return false}
+    if lhs.windowLength != rhs.windowLength {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_InputChar: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".InputChar"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "text"),
+    2: .same(proto: "direct"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.text) }()
+      case 2: try { try decoder.decodeSingularBoolField(value: &self.direct) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.text.isEmpty {
+      try visitor.visitSingularStringField(value: self.text, fieldNumber: 1)
+    }
+    if self.direct != false {
+      try visitor.visitSingularBoolField(value: self.direct, fieldNumber: 2)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_InputChar, rhs: Hazkey_Commands_InputChar) -> Bool {
+    if lhs.text != rhs.text {return false}
+    if lhs.direct != rhs.direct {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_ModifierEvent: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".ModifierEvent"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .standard(proto: "mod_type"),
+    2: .standard(proto: "event_type"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularEnumField(value: &self.modType) }()
+      case 2: try { try decoder.decodeSingularEnumField(value: &self.eventType) }()
+      default: break
       }
     }
   }
@@ -575,7 +1060,658 @@ extension Hazkey_Commands_MoveCursor: SwiftProtobuf.Message, SwiftProtobuf._Mess
 extension Hazkey_Commands_PrefixComplete: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
   static let protoMessageName: String = _protobuf_package + ".PrefixComplete"
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .same(proto: "index"),
+    1: .same(proto: "index"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularInt32Field(value: &self.index) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if self.index != 0 {
+      try visitor.visitSingularInt32Field(value: self.index, fieldNumber: 1)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_PrefixComplete, rhs: Hazkey_Commands_PrefixComplete) -> Bool {
+    if lhs.index != rhs.index {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_DeleteLeft: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".DeleteLeft"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_DeleteLeft, rhs: Hazkey_Commands_DeleteLeft) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_DeleteRight: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".DeleteRight"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_DeleteRight, rhs: Hazkey_Commands_DeleteRight) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_GetComposingString: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".GetComposingString"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .standard(proto: "char_type"),
+    2: .standard(proto: "current_preedit"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularEnumField(value: &self.charType) }()
+      case 2: try { try decoder.decodeSingularStringField(value: &self.currentPreedit) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if self.charType != .hiragana {
+      try visitor.visitSingularEnumField(value: self.charType, fieldNumber: 1)
+    }
+    if !self.currentPreedit.isEmpty {
+      try visitor.visitSingularStringField(value: self.currentPreedit, fieldNumber: 2)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_GetComposingString, rhs: Hazkey_Commands_GetComposingString) -> Bool {
+    if lhs.charType != rhs.charType {return false}
+    if lhs.currentPreedit != rhs.currentPreedit {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_GetComposingString.CharType: SwiftProtobuf._ProtoNameProviding {
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    0: .same(proto: "HIRAGANA"),
+    1: .same(proto: "KATAKANA_FULL"),
+    2: .same(proto: "KATAKANA_HALF"),
+    3: .same(proto: "ALPHABET_FULL"),
+    4: .same(proto: "ALPHABET_HALF"),
+  ]
+}
+
+extension Hazkey_Commands_GetComposingVariants: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".GetComposingVariants"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_GetComposingVariants, rhs: Hazkey_Commands_GetComposingVariants) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_GetHiraganaWithCursor: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".GetHiraganaWithCursor"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_GetHiraganaWithCursor, rhs: Hazkey_Commands_GetHiraganaWithCursor) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_GetCandidates: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".GetCandidates"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .standard(proto: "is_suggest"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularBoolField(value: &self.isSuggest) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if self.isSuggest != false {
+      try visitor.visitSingularBoolField(value: self.isSuggest, fieldNumber: 1)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_GetCandidates, rhs: Hazkey_Commands_GetCandidates) -> Bool {
+    if lhs.isSuggest != rhs.isSuggest {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_GetLiveText: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".GetLiveText"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_GetLiveText, rhs: Hazkey_Commands_GetLiveText) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_GetCurrentInputModeInfo: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".GetCurrentInputModeInfo"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_GetCurrentInputModeInfo, rhs: Hazkey_Commands_GetCurrentInputModeInfo) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_SaveLearningData: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".SaveLearningData"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_SaveLearningData, rhs: Hazkey_Commands_SaveLearningData) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_GetServerStatus: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".GetServerStatus"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_GetServerStatus, rhs: Hazkey_Commands_GetServerStatus) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_GetStats: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".GetStats"
+  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    // Load everything into unknown fields
+    while try decoder.nextFieldNumber() != nil {}
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_GetStats, rhs: Hazkey_Commands_GetStats) -> Bool {
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_ConvertBatch: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".ConvertBatch"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "inputs"),
+    2: .standard(proto: "n_best"),
+    3: .same(proto: "workers"),
+    4: .standard(proto: "left_contexts"),
+    5: .standard(proto: "use_profile"),
+    6: .same(proto: "profile"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeRepeatedStringField(value: &self.inputs) }()
+      case 2: try { try decoder.decodeSingularInt32Field(value: &self.nBest) }()
+      case 3: try { try decoder.decodeSingularInt32Field(value: &self.workers) }()
+      case 4: try { try decoder.decodeRepeatedStringField(value: &self.leftContexts) }()
+      case 5: try { try decoder.decodeSingularBoolField(value: &self.useProfile) }()
+      case 6: try { try decoder.decodeSingularMessageField(value: &self._profile) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    // The use of inline closures is to circumvent an issue where the compiler
+    // allocates stack space for every if/case branch local when no optimizations
+    // are enabled. https://github.com/apple/swift-protobuf/issues/1034 and
+    // https://github.com/apple/swift-protobuf/issues/1182
+    if !self.inputs.isEmpty {
+      try visitor.visitRepeatedStringField(value: self.inputs, fieldNumber: 1)
+    }
+    if self.nBest != 0 {
+      try visitor.visitSingularInt32Field(value: self.nBest, fieldNumber: 2)
+    }
+    if self.workers != 0 {
+      try visitor.visitSingularInt32Field(value: self.workers, fieldNumber: 3)
+    }
+    if !self.leftContexts.isEmpty {
+      try visitor.visitRepeatedStringField(value: self.leftContexts, fieldNumber: 4)
+    }
+    if self.useProfile != false {
+      try visitor.visitSingularBoolField(value: self.useProfile, fieldNumber: 5)
+    }
+    try { if let v = self._profile {
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 6)
+    } }()
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_ConvertBatch, rhs: Hazkey_Commands_ConvertBatch) -> Bool {
+    if lhs.inputs != rhs.inputs {return false}
+    if lhs.nBest != rhs.nBest {return false}
+    if lhs.workers != rhs.workers {return false}
+    if lhs.leftContexts != rhs.leftContexts {return false}
+    if lhs.useProfile != rhs.useProfile {return false}
+    if lhs._profile != rhs._profile {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_RunBenchmark: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".RunBenchmark"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "settings"),
+    2: .same(proto: "iterations"),
+    3: .standard(proto: "first_sample"),
+    4: .standard(proto: "sample_count"),
+    5: .standard(proto: "warm_up"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeRepeatedMessageField(value: &self.settings) }()
+      case 2: try { try decoder.decodeSingularInt32Field(value: &self.iterations) }()
+      case 3: try { try decoder.decodeSingularInt32Field(value: &self.firstSample) }()
+      case 4: try { try decoder.decodeSingularInt32Field(value: &self.sampleCount) }()
+      case 5: try { try decoder.decodeSingularBoolField(value: &self.warmUp) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.settings.isEmpty {
+      try visitor.visitRepeatedMessageField(value: self.settings, fieldNumber: 1)
+    }
+    if self.iterations != 0 {
+      try visitor.visitSingularInt32Field(value: self.iterations, fieldNumber: 2)
+    }
+    if self.firstSample != 0 {
+      try visitor.visitSingularInt32Field(value: self.firstSample, fieldNumber: 3)
+    }
+    if self.sampleCount != 0 {
+      try visitor.visitSingularInt32Field(value: self.sampleCount, fieldNumber: 4)
+    }
+    if self.warmUp != false {
+      try visitor.visitSingularBoolField(value: self.warmUp, fieldNumber: 5)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_RunBenchmark, rhs: Hazkey_Commands_RunBenchmark) -> Bool {
+    if lhs.settings != rhs.settings {return false}
+    if lhs.iterations != rhs.iterations {return false}
+    if lhs.firstSample != rhs.firstSample {return false}
+    if lhs.sampleCount != rhs.sampleCount {return false}
+    if lhs.warmUp != rhs.warmUp {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_RunBenchmark.Setting: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = Hazkey_Commands_RunBenchmark.protoMessageName + ".Setting"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .standard(proto: "zenzai_enable"),
+    2: .standard(proto: "zenzai_infer_limit"),
+    3: .standard(proto: "zenzai_backend_device_name"),
+    4: .standard(proto: "zenzai_contextual_mode"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularBoolField(value: &self.zenzaiEnable) }()
+      case 2: try { try decoder.decodeSingularInt32Field(value: &self.zenzaiInferLimit) }()
+      case 3: try { try decoder.decodeSingularStringField(value: &self.zenzaiBackendDeviceName) }()
+      case 4: try { try decoder.decodeSingularBoolField(value: &self.zenzaiContextualMode) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if self.zenzaiEnable != false {
+      try visitor.visitSingularBoolField(value: self.zenzaiEnable, fieldNumber: 1)
+    }
+    if self.zenzaiInferLimit != 0 {
+      try visitor.visitSingularInt32Field(value: self.zenzaiInferLimit, fieldNumber: 2)
+    }
+    if !self.zenzaiBackendDeviceName.isEmpty {
+      try visitor.visitSingularStringField(value: self.zenzaiBackendDeviceName, fieldNumber: 3)
+    }
+    if self.zenzaiContextualMode != false {
+      try visitor.visitSingularBoolField(value: self.zenzaiContextualMode, fieldNumber: 4)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_RunBenchmark.Setting, rhs: Hazkey_Commands_RunBenchmark.Setting) -> Bool {
+    if lhs.zenzaiEnable != rhs.zenzaiEnable {return false}
+    if lhs.zenzaiInferLimit != rhs.zenzaiInferLimit {return false}
+    if lhs.zenzaiBackendDeviceName != rhs.zenzaiBackendDeviceName {return false}
+    if lhs.zenzaiContextualMode != rhs.zenzaiContextualMode {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_Text: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".Text"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "text"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.text) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.text.isEmpty {
+      try visitor.visitSingularStringField(value: self.text, fieldNumber: 1)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_Text, rhs: Hazkey_Commands_Text) -> Bool {
+    if lhs.text != rhs.text {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_TextWithCursor: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".TextWithCursor"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "beforeCursosr"),
+    2: .same(proto: "onCursor"),
+    3: .same(proto: "afterCursor"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.beforeCursosr) }()
+      case 2: try { try decoder.decodeSingularStringField(value: &self.onCursor) }()
+      case 3: try { try decoder.decodeSingularStringField(value: &self.afterCursor) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.beforeCursosr.isEmpty {
+      try visitor.visitSingularStringField(value: self.beforeCursosr, fieldNumber: 1)
+    }
+    if !self.onCursor.isEmpty {
+      try visitor.visitSingularStringField(value: self.onCursor, fieldNumber: 2)
+    }
+    if !self.afterCursor.isEmpty {
+      try visitor.visitSingularStringField(value: self.afterCursor, fieldNumber: 3)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_TextWithCursor, rhs: Hazkey_Commands_TextWithCursor) -> Bool {
+    if lhs.beforeCursosr != rhs.beforeCursosr {return false}
+    if lhs.onCursor != rhs.onCursor {return false}
+    if lhs.afterCursor != rhs.afterCursor {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_ComposingVariants: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".ComposingVariants"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "hiragana"),
+    2: .standard(proto: "katakana_full"),
+    3: .standard(proto: "katakana_half"),
+    4: .standard(proto: "alphabet_full"),
+    5: .standard(proto: "alphabet_half"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.hiragana) }()
+      case 2: try { try decoder.decodeSingularStringField(value: &self.katakanaFull) }()
+      case 3: try { try decoder.decodeSingularStringField(value: &self.katakanaHalf) }()
+      case 4: try { try decoder.decodeRepeatedStringField(value: &self.alphabetFull) }()
+      case 5: try { try decoder.decodeRepeatedStringField(value: &self.alphabetHalf) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.hiragana.isEmpty {
+      try visitor.visitSingularStringField(value: self.hiragana, fieldNumber: 1)
+    }
+    if !self.katakanaFull.isEmpty {
+      try visitor.visitSingularStringField(value: self.katakanaFull, fieldNumber: 2)
+    }
+    if !self.katakanaHalf.isEmpty {
+      try visitor.visitSingularStringField(value: self.katakanaHalf, fieldNumber: 3)
+    }
+    if !self.alphabetFull.isEmpty {
+      try visitor.visitRepeatedStringField(value: self.alphabetFull, fieldNumber: 4)
+    }
+    if !self.alphabetHalf.isEmpty {
+      try visitor.visitRepeatedStringField(value: self.alphabetHalf, fieldNumber: 5)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_ComposingVariants, rhs: Hazkey_Commands_ComposingVariants) -> Bool {
+    if lhs.hiragana != rhs.hiragana {return false}
+    if lhs.katakanaFull != rhs.katakanaFull {return false}
+    if lhs.katakanaHalf != rhs.katakanaHalf {return false}
+    if lhs.alphabetFull != rhs.alphabetFull {return false}
+    if lhs.alphabetHalf != rhs.alphabetHalf {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_CandidatesResult: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".CandidatesResult"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "candidates"),
+    2: .standard(proto: "live_text"),
+    3: .standard(proto: "live_text_index"),
+    4: .standard(proto: "page_size"),
+    5: .standard(proto: "warming_up"),
+    6: .same(proto: "reading"),
+  ]
+
+  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeRepeatedMessageField(value: &self.candidates) }()
+      case 2: try { try decoder.decodeSingularStringField(value: &self.liveText) }()
+      case 3: try { try decoder.decodeSingularInt32Field(value: &self.liveTextIndex) }()
+      case 4: try { try decoder.decodeSingularInt32Field(value: &self.pageSize) }()
+      case 5: try { try decoder.decodeSingularBoolField(value: &self.warmingUp) }()
+      case 6: try { try decoder.decodeSingularStringField(value: &self.reading) }()
+      default: break
+      }
+    }
+  }
+
+  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.candidates.isEmpty {
+      try visitor.visitRepeatedMessageField(value: self.candidates, fieldNumber: 1)
+    }
+    if !self.liveText.isEmpty {
+      try visitor.visitSingularStringField(value: self.liveText, fieldNumber: 2)
+    }
+    if self.liveTextIndex != 0 {
+      try visitor.visitSingularInt32Field(value: self.liveTextIndex, fieldNumber: 3)
+    }
+    if self.pageSize != 0 {
+      try visitor.visitSingularInt32Field(value: self.pageSize, fieldNumber: 4)
+    }
+    if self.warmingUp != false {
+      try visitor.visitSingularBoolField(value: self.warmingUp, fieldNumber: 5)
+    }
+    if !self.reading.isEmpty {
+      try visitor.visitSingularStringField(value: self.reading, fieldNumber: 6)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  static func ==(lhs: Hazkey_Commands_CandidatesResult, rhs: Hazkey_Commands_CandidatesResult) -> Bool {
+    if lhs.candidates != rhs.candidates {return false}
+    if lhs.liveText != rhs.liveText {return false}
+    if lhs.liveTextIndex != rhs.liveTextIndex {return false}
+    if lhs.pageSize != rhs.pageSize {return false}
+    if lhs.warmingUp != rhs.warmingUp {return false}
+    if lhs.reading != rhs.reading {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Hazkey_Commands_CandidatesResult.Candidate: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = Hazkey_Commands_CandidatesResult.protoMessageName + ".Candidate"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "text"),
+    2: .standard(proto: "sub_hiragana"),
+    3: .standard(proto: "consumed_bytes"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -584,69 +1720,81 @@ extension Hazkey_Commands_PrefixComplete: SwiftProtobuf.Message, SwiftProtobuf._
       // allocates stack space for every case branch when no optimizations are
       // enabled. https://github.com/apple/swift-protobuf/issues/1034
       switch fieldNumber {
-      case 1: try { try decoder.decodeSingularInt32Field(value: &self.index) }()
+      case 1: try { try decoder.decodeSingularStringField(value: &self.text) }()
+      case 2: try { try decoder.decodeSingularStringField(value: &self.subHiragana) }()
+      case 3: try { try decoder.decodeSingularInt32Field(value: &self.consumedBytes) }()
       default: break
       }
     }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if self.index != 0 {
-      try visitor.visitSingularInt32Field(value: self.index, fieldNumber: 1)
+    if !self.text.isEmpty {
+      try visitor.visitSingularStringField(value: self.text, fieldNumber: 1)
+    }
+    if !self.subHiragana.isEmpty {
+      try visitor.visitSingularStringField(value: self.subHiragana, fieldNumber: 2)
+    }
+    if self.consumedBytes != 0 {
+      try visitor.visitSingularInt32Field(value: self.consumedBytes, fieldNumber: 3)
     }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_PrefixComplete, rhs: Hazkey_Commands_PrefixComplete) -> Bool {
-    if lhs.index != rhs.index {return false}
+  static func ==(lhs: Hazkey_Commands_CandidatesResult.Candidate, rhs: Hazkey_Commands_CandidatesResult.Candidate) -> Bool {
+    if lhs.text != rhs.text {return false}
+    if lhs.subHiragana != rhs.subHiragana {return false}
+    if lhs.consumedBytes != rhs.consumedBytes {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_DeleteLeft: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".DeleteLeft"
-  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+extension Hazkey_Commands_CurrentInputModeInfo: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".CurrentInputModeInfo"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .standard(proto: "input_mode"),
+  ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    // Load everything into unknown fields
-    while try decoder.nextFieldNumber() != nil {}
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularEnumField(value: &self.inputMode) }()
+      default: break
+      }
+    }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if self.inputMode != .normal {
+      try visitor.visitSingularEnumField(value: self.inputMode, fieldNumber: 1)
+    }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_DeleteLeft, rhs: Hazkey_Commands_DeleteLeft) -> Bool {
+  static func ==(lhs: Hazkey_Commands_CurrentInputModeInfo, rhs: Hazkey_Commands_CurrentInputModeInfo) -> Bool {
+    if lhs.inputMode != rhs.inputMode {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_DeleteRight: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".DeleteRight"
-  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
-
-  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    // Load everything into unknown fields
-    while try decoder.nextFieldNumber() != nil {}
-  }
-
-  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    try unknownFields.traverse(visitor: &visitor)
-  }
-
-  static func ==(lhs: Hazkey_Commands_DeleteRight, rhs: Hazkey_Commands_DeleteRight) -> Bool {
-    if lhs.unknownFields != rhs.unknownFields {return false}
-    return true
-  }
+extension Hazkey_Commands_CurrentInputModeInfo.InputMode: SwiftProtobuf._ProtoNameProviding {
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    0: .same(proto: "NORMAL"),
+    1: .same(proto: "DIRECT"),
+  ]
 }
 
-extension Hazkey_Commands_GetComposingString: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".GetComposingString"
+extension Hazkey_Commands_ServerStatus: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".ServerStatus"
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .standard(proto: "char_type"),
-    2: .standard(proto: "current_preedit"),
+    1: .standard(proto: "warm_up_state"),
+    2: .standard(proto: "zenzai_loaded"),
+    3: .standard(proto: "warm_up_time_ms"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -655,64 +1803,62 @@ extension Hazkey_Commands_GetComposingString: SwiftProtobuf.Message, SwiftProtob
       // allocates stack space for every case branch when no optimizations are
       // enabled. https://github.com/apple/swift-protobuf/issues/1034
       switch fieldNumber {
-      case 1: try { try decoder.decodeSingularEnumField(value: &self.charType) }()
-      case 2: try { try decoder.decodeSingularStringField(value: &self.currentPreedit) }()
+      case 1: try { try decoder.decodeSingularEnumField(value: &self.warmUpState) }()
+      case 2: try { try decoder.decodeSingularBoolField(value: &self.zenzaiLoaded) }()
+      case 3: try { try decoder.decodeSingularInt64Field(value: &self.warmUpTimeMs) }()
       default: break
       }
     }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if self.charType != .hiragana {
-      try visitor.visitSingularEnumField(value: self.charType, fieldNumber: 1)
+    if self.warmUpState != .unspecified {
+      try visitor.visitSingularEnumField(value: self.warmUpState, fieldNumber: 1)
     }
-    if !self.currentPreedit.isEmpty {
-      try visitor.visitSingularStringField(value: self.currentPreedit, fieldNumber: 2)
+    if self.zenzaiLoaded != false {
+      try visitor.visitSingularBoolField(value: self.zenzaiLoaded, fieldNumber: 2)
+    }
+    if self.warmUpTimeMs != 0 {
+      try visitor.visitSingularInt64Field(value: self.warmUpTimeMs, fieldNumber: 3)
     }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_GetComposingString, rhs: Hazkey_Commands_GetComposingString) -> Bool {
-    if lhs.charType != rhs.charType {return false}
-    if lhs.currentPreedit != rhs.currentPreedit {return false}
+  static func ==(lhs: Hazkey_Commands_ServerStatus, rhs: Hazkey_Commands_ServerStatus) -> Bool {
+    if lhs.warmUpState != rhs.warmUpState {return false}
+    if lhs.zenzaiLoaded != rhs.zenzaiLoaded {return false}
+    if lhs.warmUpTimeMs != rhs.warmUpTimeMs {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_GetComposingString.CharType: SwiftProtobuf._ProtoNameProviding {
+extension Hazkey_Commands_ServerStatus.WarmUpState: SwiftProtobuf._ProtoNameProviding {
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    0: .same(proto: "HIRAGANA"),
-    1: .same(proto: "KATAKANA_FULL"),
-    2: .same(proto: "KATAKANA_HALF"),
-    3: .same(proto: "ALPHABET_FULL"),
-    4: .same(proto: "ALPHABET_HALF"),
+    0: .same(proto: "WARM_UP_STATE_UNSPECIFIED"),
+    1: .same(proto: "WARMING_UP"),
+    2: .same(proto: "READY"),
+    3: .same(proto: "DISABLED"),
   ]
 }
 
-extension Hazkey_Commands_GetHiraganaWithCursor: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".GetHiraganaWithCursor"
-  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
-
-  mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    // Load everything into unknown fields
-    while try decoder.nextFieldNumber() != nil {}
-  }
-
-  func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    try unknownFields.traverse(visitor: &visitor)
-  }
-
-  static func ==(lhs: Hazkey_Commands_GetHiraganaWithCursor, rhs: Hazkey_Commands_GetHiraganaWithCursor) -> Bool {
-    if lhs.unknownFields != rhs.unknownFields {return false}
-    return true
-  }
-}
-
-extension Hazkey_Commands_GetCandidates: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".GetCandidates"
+extension Hazkey_Commands_ServerStats: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".ServerStats"
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .standard(proto: "is_suggest"),
+    1: .same(proto: "commands"),
+    2: .standard(proto: "histogram_bounds_us"),
+    3: .standard(proto: "lattice_conversions"),
+    4: .standard(proto: "lattice_time_us"),
+    5: .standard(proto: "zenzai_conversions"),
+    6: .standard(proto: "zenzai_time_us"),
+    7: .same(proto: "caches"),
+    8: .standard(proto: "learning_data_bytes"),
+    9: .standard(proto: "rss_bytes"),
+    10: .standard(proto: "zenzai_available"),
+    11: .standard(proto: "zenzai_loaded"),
+    12: .standard(proto: "uptime_ms"),
+    13: .standard(proto: "config_save_error"),
+    14: .standard(proto: "in_process"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -721,68 +1867,197 @@ extension Hazkey_Commands_GetCandidates: SwiftProtobuf.Message, SwiftProtobuf._M
       // allocates stack space for every case branch when no optimizations are
       // enabled. https://github.com/apple/swift-protobuf/issues/1034
       switch fieldNumber {
-      case 1: try { try decoder.decodeSingularBoolField(value: &self.isSuggest) }()
+      case 1: try { try decoder.decodeRepeatedMessageField(value: &self.commands) }()
+      case 2: try { try decoder.decodeRepeatedInt64Field(value: &self.histogramBoundsUs) }()
+      case 3: try { try decoder.decodeSingularInt64Field(value: &self.latticeConversions) }()
+      case 4: try { try decoder.decodeSingularInt64Field(value: &self.latticeTimeUs) }()
+      case 5: try { try decoder.decodeSingularInt64Field(value: &self.zenzaiConversions) }()
+      case 6: try { try decoder.decodeSingularInt64Field(value: &self.zenzaiTimeUs) }()
+      case 7: try { try decoder.decodeRepeatedMessageField(value: &self.caches) }()
+      case 8: try { try decoder.decodeSingularInt64Field(value: &self.learningDataBytes) }()
+      case 9: try { try decoder.decodeSingularInt64Field(value: &self.rssBytes) }()
+      case 10: try { try decoder.decodeSingularBoolField(value: &self.zenzaiAvailable) }()
+      case 11: try { try decoder.decodeSingularBoolField(value: &self.zenzaiLoaded) }()
+      case 12: try { try decoder.decodeSingularInt64Field(value: &self.uptimeMs) }()
+      case 13: try { try decoder.decodeSingularStringField(value: &self.configSaveError) }()
+      case 14: try { try decoder.decodeSingularBoolField(value: &self.inProcess) }()
       default: break
       }
     }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if self.isSuggest != false {
-      try visitor.visitSingularBoolField(value: self.isSuggest, fieldNumber: 1)
+    if !self.commands.isEmpty {
+      try visitor.visitRepeatedMessageField(value: self.commands, fieldNumber: 1)
+    }
+    if !self.histogramBoundsUs.isEmpty {
+      try visitor.visitPackedInt64Field(value: self.histogramBoundsUs, fieldNumber: 2)
+    }
+    if self.latticeConversions != 0 {
+      try visitor.visitSingularInt64Field(value: self.latticeConversions, fieldNumber: 3)
+    }
+    if self.latticeTimeUs != 0 {
+      try visitor.visitSingularInt64Field(value: self.latticeTimeUs, fieldNumber: 4)
+    }
+    if self.zenzaiConversions != 0 {
+      try visitor.visitSingularInt64Field(value: self.zenzaiConversions, fieldNumber: 5)
+    }
+    if self.zenzaiTimeUs != 0 {
+      try visitor.visitSingularInt64Field(value: self.zenzaiTimeUs, fieldNumber: 6)
+    }
+    if !self.caches.isEmpty {
+      try visitor.visitRepeatedMessageField(value: self.caches, fieldNumber: 7)
+    }
+    if self.learningDataBytes != 0 {
+      try visitor.visitSingularInt64Field(value: self.learningDataBytes, fieldNumber: 8)
+    }
+    if self.rssBytes != 0 {
+      try visitor.visitSingularInt64Field(value: self.rssBytes, fieldNumber: 9)
+    }
+    if self.zenzaiAvailable != false {
+      try visitor.visitSingularBoolField(value: self.zenzaiAvailable, fieldNumber: 10)
+    }
+    if self.zenzaiLoaded != false {
+      try visitor.visitSingularBoolField(value: self.zenzaiLoaded, fieldNumber: 11)
+    }
+    if self.uptimeMs != 0 {
+      try visitor.visitSingularInt64Field(value: self.uptimeMs, fieldNumber: 12)
+    }
+    if !self.configSaveError.isEmpty {
+      try visitor.visitSingularStringField(value: self.configSaveError, fieldNumber: 13)
+    }
+    if self.inProcess != false {
+      try visitor.visitSingularBoolField(value: self.inProcess, fieldNumber: 14)
     }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_GetCandidates, rhs: Hazkey_Commands_GetCandidates) -> Bool {
-    if lhs.isSuggest != rhs.isSuggest {return false}
+  static func ==(lhs: Hazkey_Commands_ServerStats, rhs: Hazkey_Commands_ServerStats) -> Bool {
+    if lhs.commands != rhs.commands {return false}
+    if lhs.histogramBoundsUs != rhs.histogramBoundsUs {return false}
+    if lhs.latticeConversions != rhs.latticeConversions {return false}
+    if lhs.latticeTimeUs != rhs.latticeTimeUs {return false}
+    if lhs.zenzaiConversions != rhs.zenzaiConversions {return false}
+    if lhs.zenzaiTimeUs != rhs.zenzaiTimeUs {return false}
+    if lhs.caches != rhs.caches {return false}
+    if lhs.learningDataBytes != rhs.learningDataBytes {return false}
+    if lhs.rssBytes != rhs.rssBytes {return false}
+    if lhs.zenzaiAvailable != rhs.zenzaiAvailable {return false}
+    if lhs.zenzaiLoaded != rhs.zenzaiLoaded {return false}
+    if lhs.uptimeMs != rhs.uptimeMs {return false}
+    if lhs.configSaveError != rhs.configSaveError {return false}
+    if lhs.inProcess != rhs.inProcess {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_GetCurrentInputModeInfo: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".GetCurrentInputModeInfo"
-  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+extension Hazkey_Commands_ServerStats.CommandStats: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = Hazkey_Commands_ServerStats.protoMessageName + ".CommandStats"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "command"),
+    2: .same(proto: "count"),
+    3: .standard(proto: "total_us"),
+    4: .standard(proto: "max_us"),
+    5: .same(proto: "histogram"),
+  ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    // Load everything into unknown fields
-    while try decoder.nextFieldNumber() != nil {}
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.command) }()
+      case 2: try { try decoder.decodeSingularInt64Field(value: &self.count) }()
+      case 3: try { try decoder.decodeSingularInt64Field(value: &self.totalUs) }()
+      case 4: try { try decoder.decodeSingularInt64Field(value: &self.maxUs) }()
+      case 5: try { try decoder.decodeRepeatedInt64Field(value: &self.histogram) }()
+      default: break
+      }
+    }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.command.isEmpty {
+      try visitor.visitSingularStringField(value: self.command, fieldNumber: 1)
+    }
+    if self.count != 0 {
+      try visitor.visitSingularInt64Field(value: self.count, fieldNumber: 2)
+    }
+    if self.totalUs != 0 {
+      try visitor.visitSingularInt64Field(value: self.totalUs, fieldNumber: 3)
+    }
+    if self.maxUs != 0 {
+      try visitor.visitSingularInt64Field(value: self.maxUs, fieldNumber: 4)
+    }
+    if !self.histogram.isEmpty {
+      try visitor.visitPackedInt64Field(value: self.histogram, fieldNumber: 5)
+    }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_GetCurrentInputModeInfo, rhs: Hazkey_Commands_GetCurrentInputModeInfo) -> Bool {
+  static func ==(lhs: Hazkey_Commands_ServerStats.CommandStats, rhs: Hazkey_Commands_ServerStats.CommandStats) -> Bool {
+    if lhs.command != rhs.command {return false}
+    if lhs.count != rhs.count {return false}
+    if lhs.totalUs != rhs.totalUs {return false}
+    if lhs.maxUs != rhs.maxUs {return false}
+    if lhs.histogram != rhs.histogram {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_SaveLearningData: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".SaveLearningData"
-  static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+extension Hazkey_Commands_ServerStats.CacheStats: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = Hazkey_Commands_ServerStats.protoMessageName + ".CacheStats"
+  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
+    1: .same(proto: "name"),
+    2: .same(proto: "hits"),
+    3: .same(proto: "lookups"),
+  ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    // Load everything into unknown fields
-    while try decoder.nextFieldNumber() != nil {}
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.name) }()
+      case 2: try { try decoder.decodeSingularInt64Field(value: &self.hits) }()
+      case 3: try { try decoder.decodeSingularInt64Field(value: &self.lookups) }()
+      default: break
+      }
+    }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.name.isEmpty {
+      try visitor.visitSingularStringField(value: self.name, fieldNumber: 1)
+    }
+    if self.hits != 0 {
+      try visitor.visitSingularInt64Field(value: self.hits, fieldNumber: 2)
+    }
+    if self.lookups != 0 {
+      try visitor.visitSingularInt64Field(value: self.lookups, fieldNumber: 3)
+    }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_SaveLearningData, rhs: Hazkey_Commands_SaveLearningData) -> Bool {
+  static func ==(lhs: Hazkey_Commands_ServerStats.CacheStats, rhs: Hazkey_Commands_ServerStats.CacheStats) -> Bool {
+    if lhs.name != rhs.name {return false}
+    if lhs.hits != rhs.hits {return false}
+    if lhs.lookups != rhs.lookups {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_Text: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".Text"
+extension Hazkey_Commands_BatchResult: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".BatchResult"
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .same(proto: "text"),
+    1: .same(proto: "items"),
+    2: .same(proto: "workers"),
+    3: .standard(proto: "elapsed_us"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -791,32 +2066,41 @@ extension Hazkey_Commands_Text: SwiftProtobuf.Message, SwiftProtobuf._MessageImp
       // allocates stack space for every case branch when no optimizations are
       // enabled. https://github.com/apple/swift-protobuf/issues/1034
       switch fieldNumber {
-      case 1: try { try decoder.decodeSingularStringField(value: &self.text) }()
+      case 1: try { try decoder.decodeRepeatedMessageField(value: &self.items) }()
+      case 2: try { try decoder.decodeSingularInt32Field(value: &self.workers) }()
+      case 3: try { try decoder.decodeSingularInt64Field(value: &self.elapsedUs) }()
       default: break
       }
     }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if !self.text.isEmpty {
-      try visitor.visitSingularStringField(value: self.text, fieldNumber: 1)
+    if !self.items.isEmpty {
+      try visitor.visitRepeatedMessageField(value: self.items, fieldNumber: 1)
+    }
+    if self.workers != 0 {
+      try visitor.visitSingularInt32Field(value: self.workers, fieldNumber: 2)
+    }
+    if self.elapsedUs != 0 {
+      try visitor.visitSingularInt64Field(value: self.elapsedUs, fieldNumber: 3)
     }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_Text, rhs: Hazkey_Commands_Text) -> Bool {
-    if lhs.text != rhs.text {return false}
+  static func ==(lhs: Hazkey_Commands_BatchResult, rhs: Hazkey_Commands_BatchResult) -> Bool {
+    if lhs.items != rhs.items {return false}
+    if lhs.workers != rhs.workers {return false}
+    if lhs.elapsedUs != rhs.elapsedUs {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_TextWithCursor: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".TextWithCursor"
+extension Hazkey_Commands_BatchResult.Item: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = Hazkey_Commands_BatchResult.protoMessageName + ".Item"
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .same(proto: "beforeCursosr"),
-    2: .same(proto: "onCursor"),
-    3: .same(proto: "afterCursor"),
+    1: .same(proto: "candidates"),
+    2: .standard(proto: "latency_us"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -825,43 +2109,36 @@ extension Hazkey_Commands_TextWithCursor: SwiftProtobuf.Message, SwiftProtobuf._
       // allocates stack space for every case branch when no optimizations are
       // enabled. https://github.com/apple/swift-protobuf/issues/1034
       switch fieldNumber {
-      case 1: try { try decoder.decodeSingularStringField(value: &self.beforeCursosr) }()
-      case 2: try { try decoder.decodeSingularStringField(value: &self.onCursor) }()
-      case 3: try { try decoder.decodeSingularStringField(value: &self.afterCursor) }()
+      case 1: try { try decoder.decodeRepeatedStringField(value: &self.candidates) }()
+      case 2: try { try decoder.decodeSingularInt64Field(value: &self.latencyUs) }()
       default: break
       }
     }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if !self.beforeCursosr.isEmpty {
-      try visitor.visitSingularStringField(value: self.beforeCursosr, fieldNumber: 1)
-    }
-    if !self.onCursor.isEmpty {
-      try visitor.visitSingularStringField(value: self.onCursor, fieldNumber: 2)
+    if !self.candidates.isEmpty {
+      try visitor.visitRepeatedStringField(value: self.candidates, fieldNumber: 1)
     }
-    if !self.afterCursor.isEmpty {
-      try visitor.visitSingularStringField(value: self.afterCursor, fieldNumber: 3)
+    if self.latencyUs != 0 {
+      try visitor.visitSingularInt64Field(value: self.latencyUs, fieldNumber: 2)
     }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_TextWithCursor, rhs: Hazkey_Commands_TextWithCursor) -> Bool {
-    if lhs.beforeCursosr != rhs.beforeCursosr {return false}
-    if lhs.onCursor != rhs.onCursor {return false}
-    if lhs.afterCursor != rhs.afterCursor {return false}
+  static func ==(lhs: Hazkey_Commands_BatchResult.Item, rhs: Hazkey_Commands_BatchResult.Item) -> Bool {
+    if lhs.candidates != rhs.candidates {return false}
+    if lhs.latencyUs != rhs.latencyUs {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_CandidatesResult: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".CandidatesResult"
+extension Hazkey_Commands_BenchmarkResult: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".BenchmarkResult"
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .same(proto: "candidates"),
-    2: .standard(proto: "live_text"),
-    3: .standard(proto: "live_text_index"),
-    4: .standard(proto: "page_size"),
+    1: .same(proto: "settings"),
+    2: .standard(proto: "sample_set_size"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -870,46 +2147,36 @@ extension Hazkey_Commands_CandidatesResult: SwiftProtobuf.Message, SwiftProtobuf
       // allocates stack space for every case branch when no optimizations are
       // enabled. https://github.com/apple/swift-protobuf/issues/1034
       switch fieldNumber {
-      case 1: try { try decoder.decodeRepeatedMessageField(value: &self.candidates) }()
-      case 2: try { try decoder.decodeSingularStringField(value: &self.liveText) }()
-      case 3: try { try decoder.decodeSingularInt32Field(value: &self.liveTextIndex) }()
-      case 4: try { try decoder.decodeSingularInt32Field(value: &self.pageSize) }()
+      case 1: try { try decoder.decodeRepeatedMessageField(value: &self.settings) }()
+      case 2: try { try decoder.decodeSingularInt32Field(value: &self.sampleSetSize) }()
       default: break
       }
     }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if !self.candidates.isEmpty {
-      try visitor.visitRepeatedMessageField(value: self.candidates, fieldNumber: 1)
-    }
-    if !self.liveText.isEmpty {
-      try visitor.visitSingularStringField(value: self.liveText, fieldNumber: 2)
-    }
-    if self.liveTextIndex != 0 {
-      try visitor.visitSingularInt32Field(value: self.liveTextIndex, fieldNumber: 3)
+    if !self.settings.isEmpty {
+      try visitor.visitRepeatedMessageField(value: self.settings, fieldNumber: 1)
     }
-    if self.pageSize != 0 {
-      try visitor.visitSingularInt32Field(value: self.pageSize, fieldNumber: 4)
+    if self.sampleSetSize != 0 {
+      try visitor.visitSingularInt32Field(value: self.sampleSetSize, fieldNumber: 2)
     }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_CandidatesResult, rhs: Hazkey_Commands_CandidatesResult) -> Bool {
-    if lhs.candidates != rhs.candidates {return false}
-    if lhs.liveText != rhs.liveText {return false}
-    if lhs.liveTextIndex != rhs.liveTextIndex {return false}
-    if lhs.pageSize != rhs.pageSize {return false}
+  static func ==(lhs: Hazkey_Commands_BenchmarkResult, rhs: Hazkey_Commands_BenchmarkResult) -> Bool {
+    if lhs.settings != rhs.settings {return false}
+    if lhs.sampleSetSize != rhs.sampleSetSize {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_CandidatesResult.Candidate: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = Hazkey_Commands_CandidatesResult.protoMessageName + ".Candidate"
+extension Hazkey_Commands_BenchmarkResult.Setting: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = Hazkey_Commands_BenchmarkResult.protoMessageName + ".Setting"
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .same(proto: "text"),
-    2: .standard(proto: "sub_hiragana"),
+    5: .standard(proto: "zenzai_used"),
+    6: .standard(proto: "latencies_us"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -918,35 +2185,38 @@ extension Hazkey_Commands_CandidatesResult.Candidate: SwiftProtobuf.Message, Swi
       // allocates stack space for every case branch when no optimizations are
       // enabled. https://github.com/apple/swift-protobuf/issues/1034
       switch fieldNumber {
-      case 1: try { try decoder.decodeSingularStringField(value: &self.text) }()
-      case 2: try { try decoder.decodeSingularStringField(value: &self.subHiragana) }()
+      case 5: try { try decoder.decodeSingularBoolField(value: &self.zenzaiUsed) }()
+      case 6: try { try decoder.decodeRepeatedInt64Field(value: &self.latenciesUs) }()
       default: break
       }
     }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if !self.text.isEmpty {
-      try visitor.visitSingularStringField(value: self.text, fieldNumber: 1)
+    if self.zenzaiUsed != false {
+      try visitor.visitSingularBoolField(value: self.zenzaiUsed, fieldNumber: 5)
     }
-    if !self.subHiragana.isEmpty {
-      try visitor.visitSingularStringField(value: self.subHiragana, fieldNumber: 2)
+    if !self.latenciesUs.isEmpty {
+      try visitor.visitPackedInt64Field(value: self.latenciesUs, fieldNumber: 6)
     }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_CandidatesResult.Candidate, rhs: Hazkey_Commands_CandidatesResult.Candidate) -> Bool {
-    if lhs.text != rhs.text {return false}
-    if lhs.subHiragana != rhs.subHiragana {return false}
+  static func ==(lhs: Hazkey_Commands_BenchmarkResult.Setting, rhs: Hazkey_Commands_BenchmarkResult.Setting) -> Bool {
+    if lhs.zenzaiUsed != rhs.zenzaiUsed {return false}
+    if lhs.latenciesUs != rhs.latenciesUs {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
 
-extension Hazkey_Commands_CurrentInputModeInfo: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
-  static let protoMessageName: String = _protobuf_package + ".CurrentInputModeInfo"
+extension Hazkey_Commands_HelloResult: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  static let protoMessageName: String = _protobuf_package + ".HelloResult"
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    1: .standard(proto: "input_mode"),
+    1: .standard(proto: "protocol_version"),
+    2: .same(proto: "features"),
+    3: .same(proto: "version"),
+    4: .standard(proto: "submode_entry_point_chars"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -955,29 +2225,37 @@ extension Hazkey_Commands_CurrentInputModeInfo: SwiftProtobuf.Message, SwiftProt
       // allocates stack space for every case branch when no optimizations are
       // enabled. https://github.com/apple/swift-protobuf/issues/1034
       switch fieldNumber {
-      case 1: try { try decoder.decodeSingularEnumField(value: &self.inputMode) }()
+      case 1: try { try decoder.decodeSingularUInt32Field(value: &self.protocolVersion) }()
+      case 2: try { try decoder.decodeSingularUInt64Field(value: &self.features) }()
+      case 3: try { try decoder.decodeSingularStringField(value: &self.version) }()
+      case 4: try { try decoder.decodeSingularStringField(value: &self.submodeEntryPointChars) }()
       default: break
       }
     }
   }
 
   func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
-    if self.inputMode != .normal {
-      try visitor.visitSingularEnumField(value: self.inputMode, fieldNumber: 1)
+    if self.protocolVersion != 0 {
+      try visitor.visitSingularUInt32Field(value: self.protocolVersion, fieldNumber: 1)
+    }
+    if self.features != 0 {
+      try visitor.visitSingularUInt64Field(value: self.features, fieldNumber: 2)
+    }
+    if !self.version.isEmpty {
+      try visitor.visitSingularStringField(value: self.version, fieldNumber: 3)
+    }
+    if !self.submodeEntryPointChars.isEmpty {
+      try visitor.visitSingularStringField(value: self.submodeEntryPointChars, fieldNumber: 4)
     }
     try unknownFields.traverse(visitor: &visitor)
   }
 
-  static func ==(lhs: Hazkey_Commands_CurrentInputModeInfo, rhs: Hazkey_Commands_CurrentInputModeInfo) -> Bool {
-    if lhs.inputMode != rhs.inputMode {return false}
+  static func ==(lhs: Hazkey_Commands_HelloResult, rhs: Hazkey_Commands_HelloResult) -> Bool {
+    if lhs.protocolVersion != rhs.protocolVersion {return false}
+    if lhs.features != rhs.features {return false}
+    if lhs.version != rhs.version {return false}
+    if lhs.submodeEntryPointChars != rhs.submodeEntryPointChars {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
 }
-
-extension Hazkey_Commands_CurrentInputModeInfo.InputMode: SwiftProtobuf._ProtoNameProviding {
-  static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
-    0: .same(proto: "NORMAL"),
-    1: .same(proto: "DIRECT"),
-  ]
-}
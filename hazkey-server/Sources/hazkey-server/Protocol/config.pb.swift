@@ -37,6 +37,7 @@ struct Hazkey_Config_FileHash: Sendable {
     typealias RawValue = Int
     case configMain // = 0
     case inputTable // = 1
+    case keymap // = 2
     case UNRECOGNIZED(Int)
 
     init() {
@@ -47,6 +48,7 @@ struct Hazkey_Config_FileHash: Sendable {
       switch rawValue {
       case 0: self = .configMain
       case 1: self = .inputTable
+      case 2: self = .keymap
       default: self = .UNRECOGNIZED(rawValue)
       }
     }
@@ -55,6 +57,7 @@ struct Hazkey_Config_FileHash: Sendable {
       switch self {
       case .configMain: return 0
       case .inputTable: return 1
+      case .keymap: return 2
       case .UNRECOGNIZED(let i): return i
       }
     }
@@ -63,6 +66,7 @@ struct Hazkey_Config_FileHash: Sendable {
     static let allCases: [Hazkey_Config_FileHash.ConfigFileType] = [
       .configMain,
       .inputTable,
+      .keymap,
     ]
 
   }
@@ -221,6 +225,15 @@ struct Hazkey_Config_Profile: @unchecked Sendable {
   /// Clears the value of `useRichCandidates`. Subsequent reads from it will return its default value.
   mutating func clearUseRichCandidates() {_uniqueStorage()._useRichCandidates = nil}
 
+  var longInputChunkLength: Int32 {
+    get {return _storage._longInputChunkLength ?? 0}
+    set {_uniqueStorage()._longInputChunkLength = newValue}
+  }
+  /// Returns true if `longInputChunkLength` has been explicitly set.
+  var hasLongInputChunkLength: Bool {return _storage._longInputChunkLength != nil}
+  /// Clears the value of `longInputChunkLength`. Subsequent reads from it will return its default value.
+  mutating func clearLongInputChunkLength() {_uniqueStorage()._longInputChunkLength = nil}
+
   var useDefaultHistorySettings: Bool {
     get {return _storage._useDefaultHistorySettings ?? false}
     set {_uniqueStorage()._useDefaultHistorySettings = newValue}
@@ -804,6 +817,8 @@ struct Hazkey_Config_CurrentConfig: Sendable {
 
   var xdgConfigHomePath: String = String()
 
+  var saveError: String = String()
+
   var unknownFields = SwiftProtobuf.UnknownStorage()
 
   init() {}
@@ -861,6 +876,7 @@ extension Hazkey_Config_FileHash.ConfigFileType: SwiftProtobuf._ProtoNameProvidi
   static let _protobuf_nameMap: SwiftProtobuf._NameMap = [
     0: .same(proto: "CONFIG_MAIN"),
     1: .same(proto: "INPUT_TABLE"),
+    2: .same(proto: "KEYMAP"),
   ]
 }
 
@@ -1005,6 +1021,7 @@ extension Hazkey_Config_Profile: SwiftProtobuf.Message, SwiftProtobuf._MessageIm
     20: .standard(proto: "use_default_conversion_ui_settings"),
     21: .standard(proto: "num_candidates_per_page"),
     22: .standard(proto: "use_rich_candidates"),
+    24: .standard(proto: "long_input_chunk_length"),
     30: .standard(proto: "use_default_history_settings"),
     31: .standard(proto: "use_profile_independent_history"),
     32: .standard(proto: "use_input_history"),
@@ -1042,6 +1059,7 @@ extension Hazkey_Config_Profile: SwiftProtobuf.Message, SwiftProtobuf._MessageIm
     var _useDefaultConversionUiSettings: Bool? = nil
     var _numCandidatesPerPage: Int32? = nil
     var _useRichCandidates: Bool? = nil
+    var _longInputChunkLength: Int32? = nil
     var _useDefaultHistorySettings: Bool? = nil
     var _useProfileIndependentHistory: Bool? = nil
     var _useInputHistory: Bool? = nil
@@ -1086,6 +1104,7 @@ extension Hazkey_Config_Profile: SwiftProtobuf.Message, SwiftProtobuf._MessageIm
       _useDefaultConversionUiSettings = source._useDefaultConversionUiSettings
       _numCandidatesPerPage = source._numCandidatesPerPage
       _useRichCandidates = source._useRichCandidates
+      _longInputChunkLength = source._longInputChunkLength
       _useDefaultHistorySettings = source._useDefaultHistorySettings
       _useProfileIndependentHistory = source._useProfileIndependentHistory
       _useInputHistory = source._useInputHistory
@@ -1139,6 +1158,7 @@ extension Hazkey_Config_Profile: SwiftProtobuf.Message, SwiftProtobuf._MessageIm
         case 21: try { try decoder.decodeSingularInt32Field(value: &_storage._numCandidatesPerPage) }()
         case 22: try { try decoder.decodeSingularBoolField(value: &_storage._useRichCandidates) }()
         case 23: try { try decoder.decodeSingularBoolField(value: &_storage._stopStoreNewHistory) }()
+        case 24: try { try decoder.decodeSingularInt32Field(value: &_storage._longInputChunkLength) }()
         case 30: try { try decoder.decodeSingularBoolField(value: &_storage._useDefaultHistorySettings) }()
         case 31: try { try decoder.decodeSingularBoolField(value: &_storage._useProfileIndependentHistory) }()
         case 32: try { try decoder.decodeSingularBoolField(value: &_storage._useInputHistory) }()
@@ -1211,6 +1231,9 @@ extension Hazkey_Config_Profile: SwiftProtobuf.Message, SwiftProtobuf._MessageIm
       try { if let v = _storage._stopStoreNewHistory {
         try visitor.visitSingularBoolField(value: v, fieldNumber: 23)
       } }()
+      try { if let v = _storage._longInputChunkLength {
+        try visitor.visitSingularInt32Field(value: v, fieldNumber: 24)
+      } }()
       try { if let v = _storage._useDefaultHistorySettings {
         try visitor.visitSingularBoolField(value: v, fieldNumber: 30)
       } }()
@@ -1295,6 +1318,7 @@ extension Hazkey_Config_Profile: SwiftProtobuf.Message, SwiftProtobuf._MessageIm
         if _storage._useDefaultConversionUiSettings != rhs_storage._useDefaultConversionUiSettings {return false}
         if _storage._numCandidatesPerPage != rhs_storage._numCandidatesPerPage {return false}
         if _storage._useRichCandidates != rhs_storage._useRichCandidates {return false}
+        if _storage._longInputChunkLength != rhs_storage._longInputChunkLength {return false}
         if _storage._useDefaultHistorySettings != rhs_storage._useDefaultHistorySettings {return false}
         if _storage._useProfileIndependentHistory != rhs_storage._useProfileIndependentHistory {return false}
         if _storage._useInputHistory != rhs_storage._useInputHistory {return false}
@@ -1671,6 +1695,7 @@ extension Hazkey_Config_CurrentConfig: SwiftProtobuf.Message, SwiftProtobuf._Mes
     8: .standard(proto: "zenzai_model_available"),
     9: .standard(proto: "zenzai_model_path"),
     6: .standard(proto: "xdg_config_home_path"),
+    10: .standard(proto: "save_error"),
   ]
 
   mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
@@ -1687,6 +1712,7 @@ extension Hazkey_Config_CurrentConfig: SwiftProtobuf.Message, SwiftProtobuf._Mes
       case 7: try { try decoder.decodeRepeatedMessageField(value: &self.availableZenzaiBackendDevices) }()
       case 8: try { try decoder.decodeSingularBoolField(value: &self.zenzaiModelAvailable) }()
       case 9: try { try decoder.decodeSingularStringField(value: &self.zenzaiModelPath) }()
+      case 10: try { try decoder.decodeSingularStringField(value: &self.saveError) }()
       default: break
       }
     }
@@ -1717,6 +1743,9 @@ extension Hazkey_Config_CurrentConfig: SwiftProtobuf.Message, SwiftProtobuf._Mes
     if !self.zenzaiModelPath.isEmpty {
       try visitor.visitSingularStringField(value: self.zenzaiModelPath, fieldNumber: 9)
     }
+    if !self.saveError.isEmpty {
+      try visitor.visitSingularStringField(value: self.saveError, fieldNumber: 10)
+    }
     try unknownFields.traverse(visitor: &visitor)
   }
 
@@ -1729,6 +1758,7 @@ extension Hazkey_Config_CurrentConfig: SwiftProtobuf.Message, SwiftProtobuf._Mes
     if lhs.zenzaiModelAvailable != rhs.zenzaiModelAvailable {return false}
     if lhs.zenzaiModelPath != rhs.zenzaiModelPath {return false}
     if lhs.xdgConfigHomePath != rhs.xdgConfigHomePath {return false}
+    if lhs.saveError != rhs.saveError {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
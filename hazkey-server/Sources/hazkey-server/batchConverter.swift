@@ -0,0 +1,140 @@
+import Foundation
+import KanaKanjiConverterModule
+
+/// Converts many readings at once for ConvertBatch and for chunked long
+/// inputs.
+///
+/// The interactive converter keeps the state of the current composition, so
+/// these conversions run on a separate pool with one converter per worker,
+/// created on first use. The pool never learns and runs without Zenzai
+/// because every converter would load its own copy of the model.
+final class BatchConverter {
+    static let defaultWorkers = min(4, maxWorkers)
+    static let maxWorkers = max(1, ProcessInfo.processInfo.activeProcessorCount)
+
+    private let dictionaryURL: URL
+    private var converters: [KanaKanjiConverter] = []
+
+    init(dictionaryURL: URL) {
+        self.dictionaryURL = dictionaryURL
+    }
+
+    /// Called from the request loop only; the workers run inside this call.
+    /// Batches do not read the learning data either, so that results do not
+    /// depend on the user's history.
+    func convert(_ request: Hazkey_Commands_ConvertBatch, baseOptions: ConvertRequestOptions)
+        -> Hazkey_Commands_BatchResult
+    {
+        let requestedWorkers = request.workers > 0 ? Int(request.workers) : Self.defaultWorkers
+        let workerCount = max(1, min(requestedWorkers, Self.maxWorkers, request.inputs.count))
+
+        var options = baseOptions
+        options.N_best = max(1, Int(request.nBest))
+        options.requireJapanesePrediction = .disabled
+        options.requireEnglishPrediction = .disabled
+        options.learningType = .nothing
+        options.zenzaiMode = .off
+
+        let inputs = request.inputs
+        var items = [Hazkey_Commands_BatchResult.Item](repeating: .init(), count: inputs.count)
+        let batchStart = DispatchTime.now()
+        items.withUnsafeMutableBufferPointer { results in
+            forEachConcurrently(inputs.count, workers: workerCount) { converter, index in
+                results[index] = Self.convertOne(
+                    inputs[index], converter: converter, options: options)
+            }
+        }
+
+        return Hazkey_Commands_BatchResult.with {
+            $0.items = items
+            $0.workers = Int32(workerCount)
+            $0.elapsedUs = Self.microseconds(since: batchStart)
+        }
+    }
+
+    /// Converts the chunks of a long reading in parallel and returns the
+    /// full-length candidates of each, best first. The learning data is read
+    /// but never updated.
+    func convertChunks(_ chunks: [String], options baseOptions: ConvertRequestOptions)
+        -> [[Candidate]]
+    {
+        var options = baseOptions
+        options.requireJapanesePrediction = .disabled
+        options.requireEnglishPrediction = .disabled
+        options.learningType =
+            baseOptions.learningType == .nothing ? .nothing : .onlyOutput
+        options.zenzaiMode = .off
+
+        var candidates = [[Candidate]](repeating: [], count: chunks.count)
+        candidates.withUnsafeMutableBufferPointer { results in
+            forEachConcurrently(
+                chunks.count, workers: min(chunks.count, Self.maxWorkers)
+            ) { converter, index in
+                results[index] = Self.fullLengthCandidates(
+                    chunks[index], converter: converter, options: options)
+            }
+        }
+        return candidates
+    }
+
+    /// Converts one reading as a whole and returns the full-length candidates.
+    static func convertOne(
+        _ input: String, converter: KanaKanjiConverter, options: ConvertRequestOptions
+    ) -> Hazkey_Commands_BatchResult.Item {
+        let start = DispatchTime.now()
+        let candidates = fullLengthCandidates(input, converter: converter, options: options)
+            .prefix(options.N_best)
+            .map { $0.text }
+        return Hazkey_Commands_BatchResult.Item.with {
+            $0.candidates = candidates
+            $0.latencyUs = microseconds(since: start)
+        }
+    }
+
+    /// With `endComposition`, the converter drops its lattice afterwards,
+    /// which is only right for converters that hold no user composition.
+    static func fullLengthCandidates(
+        _ input: String, converter: KanaKanjiConverter, options: ConvertRequestOptions,
+        endComposition: Bool = true
+    ) -> [Candidate] {
+        var composingText = ComposingText()
+        composingText.insertAtCursorPosition(input, inputStyle: .direct)
+        let readingCount = composingText.toHiragana().count
+        let converted = converter.requestCandidates(composingText, options: options)
+        if endComposition {
+            // unrelated inputs share nothing, so do not keep the lattice around
+            converter.stopComposition()
+        }
+        return converted.mainResults.filter { $0.rubyCount == readingCount }
+    }
+
+    static func microseconds(since start: DispatchTime) -> Int64 {
+        return Int64((DispatchTime.now().uptimeNanoseconds - start.uptimeNanoseconds) / 1000)
+    }
+
+    // Runs `body` for every index in 0..<count, each worker pulling the next
+    // index from a shared counter.
+    private func forEachConcurrently(
+        _ count: Int, workers: Int, _ body: (KanaKanjiConverter, Int) -> Void
+    ) {
+        let workerCount = max(1, workers)
+        while converters.count < workerCount {
+            converters.append(KanaKanjiConverter(dictionaryURL: dictionaryURL))
+        }
+        let indexLock = NSLock()
+        var nextIndex = 0
+        DispatchQueue.concurrentPerform(iterations: workerCount) { worker in
+            let converter = converters[worker]
+            while true {
+                let index = indexLock.withLock {
+                    defer { nextIndex += 1 }
+                    return nextIndex
+                }
+                guard index < count else {
+                    break
+                }
+                body(converter, index)
+            }
+        }
+    }
+}
@@ -1,8 +1,95 @@
 import KanaKanjiConverterModule
 
 final class ComposingTextBox {
-    public var value: ComposingText
+    /// Every mutation, including cursor moves, starts a new revision and
+    /// drops the derived strings below.
+    public var value: ComposingText {
+        didSet {
+            revision &+= 1
+            derived = Derived()
+        }
+    }
+    private(set) var revision: UInt64 = 0
+
+    // Strings derived from `value`, computed on first use in a revision. One
+    // key stroke asks for the same forms several times.
+    private struct Derived {
+        var hiragana: String?
+        var hiraganaCount: Int?
+        var katakana: [Bool: String] = [:]
+        var alphabet: [Bool: String] = [:]
+        var cursorSplit: CursorSplit?
+    }
+    private var derived = Derived()
+
+    /// The hiragana reading split around the cursor.
+    struct CursorSplit {
+        var beforeCursor: String
+        var onCursor: String
+        var afterCursor: String
+    }
+
     init() {
         self.value = ComposingText()
     }
+
+    var hiragana: String {
+        if let hiragana = derived.hiragana {
+            return hiragana
+        }
+        let hiragana = value.toHiragana()
+        derived.hiragana = hiragana
+        return hiragana
+    }
+
+    /// Number of characters in `hiragana`.
+    var hiraganaCount: Int {
+        if let count = derived.hiraganaCount {
+            return count
+        }
+        let count = hiragana.count
+        derived.hiraganaCount = count
+        return count
+    }
+
+    func katakana(fullWidth: Bool) -> String {
+        if let katakana = derived.katakana[fullWidth] {
+            return katakana
+        }
+        let katakana = value.toKatakana(fullWidth)
+        derived.katakana[fullWidth] = katakana
+        return katakana
+    }
+
+    func alphabet(fullWidth: Bool) -> String {
+        if let alphabet = derived.alphabet[fullWidth] {
+            return alphabet
+        }
+        let alphabet = value.toAlphabet(fullWidth)
+        derived.alphabet[fullWidth] = alphabet
+        return alphabet
+    }
+
+    var cursorSplit: CursorSplit {
+        if let split = derived.cursorSplit {
+            return split
+        }
+        let split = Self.split(
+            hiragana, count: hiraganaCount, at: value.convertTargetCursorPosition)
+        derived.cursorSplit = split
+        return split
+    }
+
+    // Walks `text` once; out-of-range cursors give empty parts, as before.
+    private static func split(_ text: String, count: Int, at cursor: Int) -> CursorSplit {
+        guard cursor >= 0, cursor <= count else {
+            return CursorSplit(beforeCursor: "", onCursor: "", afterCursor: "")
+        }
+        let cursorIndex = text.index(text.startIndex, offsetBy: cursor)
+        let afterIndex = cursor < count ? text.index(after: cursorIndex) : cursorIndex
+        return CursorSplit(
+            beforeCursor: String(text[..<cursorIndex]),
+            onCursor: String(text[cursorIndex..<afterIndex]),
+            afterCursor: String(text[afterIndex...]))
+    }
 }
@@ -40,7 +40,18 @@ class HazkeyServerConfig {
     var zenzaiModelPath: URL?
     var ggmlBackendDevices: [GGMLBackendDevice]
 
-    init() {
+    // sha256 of custom tables and keymaps, sent by the settings app on SetConfig
+    private var fileHashes: [Hazkey_Config_FileHash] = []
+    // Compiled custom tables and keymaps keyed by content. Only the entries
+    // used by the current profile are kept.
+    private var inputTableCache: [String: InputTable] = [:]
+    private var keymapCache: [String: Keymap] = [:]
+    private var mergedKeymap: (key: String, keymap: Keymap)?
+    private var registeredTableName: String?
+    private let stats: ServerStats
+
+    init(stats: ServerStats) {
+        self.stats = stats
         do {
             profiles = try Self.loadConfig()
         } catch {
@@ -71,17 +82,9 @@ class HazkeyServerConfig {
         self.zenzaiAvailable = (ggmlBackendDevices.count > 0) && (zenzaiModelPath != nil)
     }
 
+    // Profiles come from memory: they are what the server is using, and
+    // config.json may be older than the last SetConfig.
     func getCurrentConfig() -> Hazkey_ResponseEnvelope {
-        let profiles: [Hazkey_Config_Profile]
-        do {
-            profiles = try Self.loadConfig()
-        } catch {
-            return Hazkey_ResponseEnvelope.with {
-                $0.status = .failed
-                $0.errorMessage = "\(error)"
-            }
-        }
-
         let userKeymapDir = Self.getConfigDirectory().appendingPathComponent(
             "keymap", isDirectory: true
         )
@@ -175,6 +178,7 @@ class HazkeyServerConfig {
             $0.availableTables = inputTables
             $0.availableZenzaiBackendDevices = zenzaiDevices
             $0.profiles = profiles
+            $0.saveError = Self.configWriter.lastError ?? ""
         }
         return Hazkey_ResponseEnvelope.with {
             $0.status = .success
@@ -187,20 +191,78 @@ class HazkeyServerConfig {
         _ profiles: [Hazkey_Config_Profile],
         state: HazkeyServerState? = nil
     ) -> Hazkey_ResponseEnvelope {
-        do {
-            try saveConfig(profiles, state: state)
-        } catch {
+        guard !profiles.isEmpty else {
             return Hazkey_ResponseEnvelope.with {
                 $0.status = .failed
-                $0.errorMessage = "\(error)"
+                $0.errorMessage = "No profile given."
             }
         }
+        var changes = Self.diffProfiles(currentProfile, profiles[0])
+        // without hashes, let the loaders check file size and mtime
+        if hashes.isEmpty || hashes != fileHashes {
+            changes.formUnion([.keymaps, .inputTables])
+        }
+        fileHashes = hashes
+        saveConfig(profiles, state: state, changes: changes)
 
         return Hazkey_ResponseEnvelope.with {
             $0.status = .success
         }
     }
 
+    /// Subsystems affected by a profile change. Fields not covered here are
+    /// read from `currentProfile` on every request and need no reload.
+    struct ConfigChanges: OptionSet {
+        let rawValue: Int
+
+        static let keymaps = ConfigChanges(rawValue: 1 << 0)
+        static let inputTables = ConfigChanges(rawValue: 1 << 1)
+        static let candidateCount = ConfigChanges(rawValue: 1 << 2)
+        static let learning = ConfigChanges(rawValue: 1 << 3)
+        static let specialProviders = ConfigChanges(rawValue: 1 << 4)
+        static let zenzai = ConfigChanges(rawValue: 1 << 5)
+
+        static let all: ConfigChanges = [
+            .keymaps, .inputTables, .candidateCount, .learning, .specialProviders, .zenzai,
+        ]
+    }
+
+    static func diffProfiles(
+        _ old: Hazkey_Config_Profile, _ new: Hazkey_Config_Profile
+    ) -> ConfigChanges {
+        var changes: ConfigChanges = []
+        if old.enabledKeymaps != new.enabledKeymaps {
+            changes.insert(.keymaps)
+        }
+        if old.enabledTables != new.enabledTables {
+            changes.insert(.inputTables)
+        }
+        if old.numCandidatesPerPage != new.numCandidatesPerPage {
+            changes.insert(.candidateCount)
+        }
+        if old.useInputHistory != new.useInputHistory
+            || old.stopStoreNewHistory != new.stopStoreNewHistory
+        {
+            changes.insert(.learning)
+        }
+        if old.specialConversionMode != new.specialConversionMode {
+            changes.insert(.specialProviders)
+        }
+        if old.zenzaiEnable != new.zenzaiEnable
+            || old.zenzaiInferLimit != new.zenzaiInferLimit
+            || old.useRichCandidates != new.useRichCandidates
+            || old.zenzaiContextualMode != new.zenzaiContextualMode
+            || old.zenzaiProfile != new.zenzaiProfile
+            || old.zenzaiTopic != new.zenzaiTopic
+            || old.zenzaiStyle != new.zenzaiStyle
+            || old.zenzaiPreference != new.zenzaiPreference
+            || old.zenzaiBackendDeviceName != new.zenzaiBackendDeviceName
+        {
+            changes.insert(.zenzai)
+        }
+        return changes
+    }
+
     static func genDefaultConfig() -> Hazkey_Config_Profile {
         var newConf = Hazkey_Config_Profile.init()
         newConf.profileName = "Default"
@@ -212,6 +274,7 @@ class HazkeyServerConfig {
         newConf.numSuggestions = 4
         newConf.useRichSuggestion = false
         newConf.numCandidatesPerPage = 9
+        newConf.longInputChunkLength = Int32(defaultLongInputChunkLength)
         newConf.useRichCandidates = false
         newConf.useInputHistory = true
         newConf.specialConversionMode = Hazkey_Config_Profile.SpecialConversionMode.with {
@@ -264,10 +327,71 @@ class HazkeyServerConfig {
         return newConf
     }
 
+    /// Applies `newProfiles` and queues writing them to config.json. A failed
+    /// write is reported by the next GetConfig and GetStats.
     func saveConfig(
         _ newProfiles: [Hazkey_Config_Profile],
-        state: HazkeyServerState? = nil
-    ) throws {
+        state: HazkeyServerState? = nil,
+        changes: ConfigChanges = .all
+    ) {
+        profiles = newProfiles
+        currentProfile = profiles[0]
+
+        if let state = state {
+            state.applyConfigChanges(changes)
+        }
+
+        // GetConfig is served from memory, so the file is only read at
+        // startup and can be written off the request path.
+        Self.configWriter.write(newProfiles)
+    }
+
+    /// Error of the last config.json write, or nil if it succeeded.
+    static var lastSaveError: String? {
+        configWriter.lastError
+    }
+
+    /// Blocks until queued config writes are on disk. Used at shutdown.
+    static func waitForPendingWrites() {
+        configWriter.wait()
+    }
+
+    private static let configWriter = ConfigWriter()
+
+    // Writes config.json on a queue of its own, so the last SetConfig wins,
+    // and keeps the outcome of the last write for the request loop.
+    fileprivate final class ConfigWriter {
+        private let queue = DispatchQueue(label: "hazkey.config-writer", qos: .utility)
+        private let lock = NSLock()
+        private var error: String?
+
+        var lastError: String? {
+            lock.lock()
+            defer { lock.unlock() }
+            return error
+        }
+
+        func write(_ profiles: [Hazkey_Config_Profile]) {
+            queue.async {
+                var failure: String?
+                do {
+                    try HazkeyServerConfig.writeConfig(profiles)
+                } catch {
+                    NSLog("Failed to save config: \(error)")
+                    failure = "\(error)"
+                }
+                self.lock.lock()
+                self.error = failure
+                self.lock.unlock()
+            }
+        }
+
+        func wait() {
+            queue.sync {}
+        }
+    }
+
+    private static func writeConfig(_ newProfiles: [Hazkey_Config_Profile]) throws {
         let configDir = Self.getConfigDirectory()
         let configPath = configDir.appendingPathComponent("config.json")
 
@@ -287,16 +411,11 @@ class HazkeyServerConfig {
         let jsonData = try JSONSerialization.data(
             withJSONObject: jsonObjects, options: [.prettyPrinted, .sortedKeys])
 
-        try jsonData.write(to: configPath)
+        // write to a temporary file and rename, so a crash never leaves a
+        // truncated config
+        try jsonData.write(to: configPath, options: .atomic)
 
         NSLog("Config saved to: \(configPath.path)")
-
-        profiles = newProfiles
-        currentProfile = profiles[0]
-
-        if let state = state {
-            state.reinitializeConfiguration()
-        }
     }
 
     static func loadConfig() throws -> [Hazkey_Config_Profile] {
@@ -385,26 +504,86 @@ class HazkeyServerConfig {
         return homeDir.appendingPathComponent(".cache").appendingPathComponent("hazkey")
     }
 
+    var isZenzaiEnabled: Bool {
+        return zenzaiAvailable && zenzaiModelPath != nil && currentProfile.zenzaiEnable
+    }
+
+    // Off unless the user opts in, so that existing configs keep converting
+    // long readings as a whole.
+    static let defaultLongInputChunkLength = 0
+
+    /// Readings longer than this are converted in chunks; 0 disables it.
+    var longInputChunkLength: Int {
+        return currentProfile.hasLongInputChunkLength
+            ? Int(currentProfile.longInputChunkLength) : Self.defaultLongInputChunkLength
+    }
+
+    static let zenzaiContextBoundaries: Set<Character> = [
+        "。", "、", "．", "，", "！", "？", "!", "?", "\n",
+    ]
+
+    /// Picks the left context for Zenzai so that its start stays put while
+    /// text is typed after it.
+    ///
+    /// Zenzai's prompt begins with the left context, so a context that only
+    /// grows at its end keeps the prompt prefix of the previous evaluation.
+    /// The start of `previous` is kept while `leftContext` still contains it
+    /// and the context fits in `limit` characters. Otherwise the start moves
+    /// forward to leave at most half of `limit`, right after a sentence
+    /// boundary if one leaves at least a quarter, and the context grows from
+    /// there again.
+    static func anchoredZenzaiLeftContext(
+        _ leftContext: String, previous: String, limit: Int
+    ) -> String {
+        if !previous.isEmpty,
+            let range = leftContext.range(of: previous, options: .backwards)
+        {
+            let anchored = leftContext[range.lowerBound...]
+            if anchored.count <= limit {
+                return String(anchored)
+            }
+        }
+        let keep = limit / 2
+        guard leftContext.count > keep else {
+            return leftContext
+        }
+        let window = leftContext.suffix(keep)
+        if let boundary = window.firstIndex(where: { zenzaiContextBoundaries.contains($0) }) {
+            let rest = window[window.index(after: boundary)...]
+            if rest.count >= keep / 2 {
+                return String(rest)
+            }
+        }
+        return String(window)
+    }
+
     func genZenzaiMode(leftContext: String)
         -> ConvertRequestOptions.ZenzaiMode
+    {
+        return genZenzaiMode(leftContext: leftContext, profile: currentProfile)
+    }
+
+    /// For trying out settings other than the current ones, e.g. in a benchmark.
+    func genZenzaiMode(leftContext: String, profile: Hazkey_Config_Profile)
+        -> ConvertRequestOptions.ZenzaiMode
     {
         let deviceName =
-            currentProfile.zenzaiBackendDeviceName.isEmpty
-            ? "CPU" : currentProfile.zenzaiBackendDeviceName
+            profile.zenzaiBackendDeviceName.isEmpty
+            ? "CPU" : profile.zenzaiBackendDeviceName
 
-        if zenzaiAvailable, let zenzaiModelPath = zenzaiModelPath, currentProfile.zenzaiEnable {
+        if zenzaiAvailable, let zenzaiModelPath = zenzaiModelPath, profile.zenzaiEnable {
             return ConvertRequestOptions.ZenzaiMode.on(
                 weight: zenzaiModelPath,
-                inferenceLimit: Int(currentProfile.zenzaiInferLimit),
-                requestRichCandidates: currentProfile.useRichCandidates,
+                inferenceLimit: Int(profile.zenzaiInferLimit),
+                requestRichCandidates: profile.useRichCandidates,
                 personalizationMode: nil,
                 versionDependentMode: .v3(
                     ConvertRequestOptions.ZenzaiV3DependentMode.init(
-                        profile: currentProfile.zenzaiProfile,
-                        topic: currentProfile.zenzaiTopic,
-                        style: currentProfile.zenzaiStyle,
-                        preference: currentProfile.zenzaiPreference,
-                        leftSideContext: currentProfile.zenzaiContextualMode
+                        profile: profile.zenzaiProfile,
+                        topic: profile.zenzaiTopic,
+                        style: profile.zenzaiStyle,
+                        preference: profile.zenzaiPreference,
+                        leftSideContext: profile.zenzaiContextualMode
                             ? leftContext : nil
                     )),
                 deviceConfig: createDeviceConfig(deviceName: deviceName)
@@ -414,30 +593,35 @@ class HazkeyServerConfig {
         }
     }
 
+    func genLearningType() -> LearningType {
+        return switch (currentProfile.useInputHistory, currentProfile.stopStoreNewHistory) {
+        case (true, false):
+            LearningType.inputAndOutput
+        case (true, true):
+            LearningType.onlyOutput
+        default:
+            LearningType.nothing
+        }
+    }
+
+    func genSpecialCandidateProviders() -> [any SpecialCandidateProvider] {
+        let mode = currentProfile.specialConversionMode
+        let providers: [SpecialCandidateProvider?] = [
+            mode.commaSeparatedNumber ? CommaSeparatedNumberSpecialCandidateProvider() : nil,
+            mode.calendar ? CalendarSpecialCandidateProvider() : nil,
+            mode.hazkeyVersion ? VersionSpecialCandidateProvider() : nil,
+            mode.mailDomain ? EmailAddressSpecialCandidateProvider() : nil,
+            mode.romanTypography ? TypographySpecialCandidateProvider() : nil,
+            mode.time ? TimeExpressionSpecialCandidateProvider() : nil,
+            mode.unicodeCodepoint ? UnicodeSpecialCandidateProvider() : nil,
+        ]
+        return providers.compactMap { $0 }
+    }
+
     func genBaseConvertRequestOptions() -> ConvertRequestOptions {
-        let learningType =
-            switch (currentProfile.useInputHistory, currentProfile.stopStoreNewHistory) {
-            case (true, false):
-                LearningType.inputAndOutput
-            case (true, true):
-                LearningType.onlyOutput
-            default:
-                LearningType.nothing
-            }
+        let learningType = genLearningType()
 
-        let specialCandidateProviders: [any SpecialCandidateProvider] = {
-            let mode = currentProfile.specialConversionMode
-            let providers: [SpecialCandidateProvider?] = [
-                mode.commaSeparatedNumber ? CommaSeparatedNumberSpecialCandidateProvider() : nil,
-                mode.calendar ? CalendarSpecialCandidateProvider() : nil,
-                mode.hazkeyVersion ? VersionSpecialCandidateProvider() : nil,
-                mode.mailDomain ? EmailAddressSpecialCandidateProvider() : nil,
-                mode.romanTypography ? TypographySpecialCandidateProvider() : nil,
-                mode.time ? TimeExpressionSpecialCandidateProvider() : nil,
-                mode.unicodeCodepoint ? UnicodeSpecialCandidateProvider() : nil,
-            ]
-            return providers.compactMap { $0 }
-        }()
+        let specialCandidateProviders = genSpecialCandidateProviders()
 
         let zenzaiMode = genZenzaiMode(leftContext: "")
 
@@ -465,11 +649,54 @@ class HazkeyServerConfig {
         )
     }
 
+    // Identifies the content of a custom table or keymap file. Uses the hash
+    // from the settings app when there is one, the file's size and mtime
+    // otherwise.
+    private func contentKey(
+        _ url: URL, filename: String, type: Hazkey_Config_FileHash.ConfigFileType
+    ) -> String {
+        if let hash = fileHashes.first(where: { $0.type == type && $0.name == filename }),
+            !hash.sha256Sum.isEmpty
+        {
+            return "sha256:\(hash.sha256Sum)"
+        }
+        let attributes = try? FileManager.default.attributesOfItem(atPath: url.path)
+        let size = attributes?[.size] as? Int ?? -1
+        let modified = (attributes?[.modificationDate] as? Date)?.timeIntervalSince1970 ?? 0
+        return "file:\(filename):\(size):\(modified)"
+    }
+
     func loadKeymap() -> Keymap {
+        var keys: [String] = []
+        var customKeymaps: [String: Keymap] = [:]
+        for enabledKeymap in currentProfile.enabledKeymaps.reversed() {
+            if enabledKeymap.isBuiltIn {
+                keys.append("builtin:\(enabledKeymap.filename)")
+                continue
+            }
+            let customKeymapFile = HazkeyServerConfig.getConfigDirectory()
+                .appendingPathComponent(
+                    "keymap", isDirectory: true
+                ).appendingPathComponent(enabledKeymap.filename, isDirectory: false)
+            let key = contentKey(customKeymapFile, filename: enabledKeymap.filename, type: .keymap)
+            keys.append(key)
+            if let cached = keymapCache[key] {
+                customKeymaps[key] = cached
+            }
+        }
+        let mergedKey = keys.joined(separator: "|")
+        let keymapCached = mergedKeymap?.key == mergedKey
+        stats.recordCacheLookup("keymap", hit: keymapCached)
+        if keymapCached, let mergedKeymap {
+            return mergedKeymap.keymap
+        }
+
         var maps: Keymap = [:]
-        outer: for enabledKeymap in currentProfile.enabledKeymaps.reversed() {
+        outer: for (enabledKeymap, cacheKey) in zip(currentProfile.enabledKeymaps.reversed(), keys) {
             var newKeymapRule: Keymap
-            if enabledKeymap.isBuiltIn {
+            if let cached = customKeymaps[cacheKey] {
+                newKeymapRule = cached
+            } else if enabledKeymap.isBuiltIn {
                 switch enabledKeymap.filename {
                 case "JIS Kana":
                     newKeymapRule = JISKanaMap
@@ -520,15 +747,23 @@ class HazkeyServerConfig {
                     )
                     continue outer
                 }
+                customKeymaps[cacheKey] = newKeymapRule
             }
             maps.merge(newKeymapRule) { (_, second) in second }
         }
 
+        keymapCache = customKeymaps
+        mergedKeymap = (mergedKey, maps)
         return maps
     }
 
-    func loadInputTable(tableName: String) {
+    /// Registers the input table of the current profile and returns its name.
+    /// The name is derived from the table contents, so applying settings with
+    /// unchanged tables keeps the registered table as is.
+    func loadInputTable() -> String {
         var tables: [InputTable] = [compositionSeparatorTable]
+        var keys: [String] = []
+        var customTables: [String: InputTable] = [:]
         outer: for enabledTable in currentProfile.enabledTables.reversed() {
             let tableToAdd: InputTable
             if enabledTable.isBuiltIn {
@@ -541,24 +776,46 @@ class HazkeyServerConfig {
                     debugLog("Unknown built-in input table: \(enabledTable.name)")
                     continue outer
                 }
+                keys.append("builtin:\(enabledTable.filename)")
             } else {
                 // load custom table
                 let customTableFile = HazkeyServerConfig.getConfigDirectory()
                     .appendingPathComponent(
                         "table", isDirectory: true
                     ).appendingPathComponent(enabledTable.filename, isDirectory: false)
-                do {
-                    tableToAdd = try InputStyleManager.loadTable(from: customTableFile)
-                } catch {
-                    NSLog("Failed to load custom table \(enabledTable.name)Q \(error)")
-                    continue outer
+                let cacheKey = contentKey(
+                    customTableFile, filename: enabledTable.filename, type: .inputTable)
+                if let cached = customTables[cacheKey] ?? inputTableCache[cacheKey] {
+                    tableToAdd = cached
+                } else {
+                    do {
+                        tableToAdd = try InputStyleManager.loadTable(from: customTableFile)
+                    } catch {
+                        NSLog("Failed to load custom table \(enabledTable.name)Q \(error)")
+                        continue outer
+                    }
                 }
+                customTables[cacheKey] = tableToAdd
+                keys.append(cacheKey)
             }
             tables.append(tableToAdd)
         }
-
-        let inputTable = InputTable(tables: tables, order: InputTable.Ordering.lastInputWins)
-        InputStyleManager.registerInputStyle(table: inputTable, for: tableName)
+        inputTableCache = customTables
+
+        let tableName = "hazkey|" + keys.joined(separator: "|")
+        stats.recordCacheLookup("input_table", hit: tableName == registeredTableName)
+        if tableName != registeredTableName {
+            let inputTable = InputTable(tables: tables, order: InputTable.Ordering.lastInputWins)
+            InputStyleManager.registerInputStyle(table: inputTable, for: tableName)
+            if let oldTableName = registeredTableName {
+                // InputStyleManager cannot unregister, so shrink the replaced
+                // table to the separator table to free it
+                InputStyleManager.registerInputStyle(
+                    table: compositionSeparatorTable, for: oldTableName)
+            }
+            registeredTableName = tableName
+        }
+        return tableName
     }
 
     func getSubModeEntryPointChars() -> [Character] {
@@ -615,3 +872,6 @@ func getZenzaiModelPath() -> URL? {
     }
     return nil
 }
+
+// `error` is guarded by `lock`; writes are serialized on `queue`.
+extension HazkeyServerConfig.ConfigWriter: @unchecked Sendable {}
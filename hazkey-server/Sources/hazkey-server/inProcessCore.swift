@@ -0,0 +1,144 @@
+import Dispatch
+import Foundation
+
+/// C ABI of libhazkey-core, which lets fcitx5-hazkey run the converter in its
+/// own process instead of talking to hazkey-server over the socket. Requests
+/// and responses are the same serialized envelopes as on the socket, so the
+/// addon only swaps the transport.
+///
+///     void *hazkey_core_create(void);
+///     int hazkey_core_transact(void *core, const uint8_t *request,
+///                              size_t request_size, uint8_t **response,
+///                              size_t *response_size);
+///     void hazkey_core_free(uint8_t *response);
+///     void hazkey_core_destroy(void *core);
+///
+/// hazkey_core_transact returns 0 on success. The response must be released
+/// with hazkey_core_free.
+///
+/// Like the server, the core assumes a single writer of the user's learning
+/// data and config. It stops a running hazkey-server and serves the
+/// hazkey-server socket itself, so hazkey-settings reaches this converter
+/// instead of starting another one.
+final class InProcessCore: SocketManagerDelegate {
+    private let state: HazkeyServerState
+    private let protocolHandler: ProtocolHandler
+    // the socket peer negotiates on its own, like a separate connection
+    private let socketProtocolHandler: ProtocolHandler
+    private let socketManager: SocketManager
+    private let listenerDone = DispatchSemaphore(value: 0)
+    private var listening = false
+    // the state assumes a single request loop, like the server's
+    private let lock = NSLock()
+
+    init() {
+        NSLog("Starting in-process hazkey core...")
+        state = HazkeyServerState(inProcess: true)
+        protocolHandler = ProtocolHandler(state: state)
+        socketProtocolHandler = ProtocolHandler(state: state)
+        socketManager = SocketManager(
+            socketPath: HazkeyServer.defaultSocketPath(), handlesSignals: false)
+        state.startWarmUp()
+        startListening()
+    }
+
+    private func startListening() {
+        ProcessManager().terminateRunningServer()
+        socketManager.delegate = self
+        do {
+            try socketManager.setupSocket()
+        } catch {
+            NSLog("In-process core cannot serve the socket: \(error)")
+            return
+        }
+        listening = true
+        Thread.detachNewThread { [self] in
+            socketManager.startListening()
+            listenerDone.signal()
+        }
+    }
+
+    func transact(_ request: Data) -> Data {
+        lock.lock()
+        defer { lock.unlock() }
+        return protocolHandler.processProto(data: request)
+    }
+
+    func shutdown() {
+        if listening {
+            socketManager.stopListening()
+            listenerDone.wait()
+            socketManager.closeSocket()
+        }
+        lock.lock()
+        defer { lock.unlock() }
+        state.learningPersistence.flush()
+        HazkeyServerConfig.waitForPendingWrites()
+    }
+
+    func socketManager(_ manager: SocketManager, didReceiveData data: Data, from clientFd: Int32)
+        -> Data
+    {
+        lock.lock()
+        defer { lock.unlock() }
+        return socketProtocolHandler.processProto(data: data)
+    }
+
+    func socketManager(_ manager: SocketManager, clientDidConnect clientFd: Int32) {
+        lock.lock()
+        defer { lock.unlock() }
+        socketProtocolHandler.resetPeer()
+    }
+
+    func socketManager(_ manager: SocketManager, clientDidDisconnect clientFd: Int32) {}
+}
+
+// Requests from the addon and the socket are serialized by `lock`;
+// `listening` is only written before the listener thread starts.
+extension InProcessCore: @unchecked Sendable {}
+
+@_cdecl("hazkey_core_create")
+public func hazkeyCoreCreate() -> UnsafeMutableRawPointer {
+    return Unmanaged.passRetained(InProcessCore()).toOpaque()
+}
+
+@_cdecl("hazkey_core_transact")
+public func hazkeyCoreTransact(
+    _ core: UnsafeMutableRawPointer?,
+    _ request: UnsafePointer<UInt8>?,
+    _ requestSize: Int,
+    _ response: UnsafeMutablePointer<UnsafeMutablePointer<UInt8>?>?,
+    _ responseSize: UnsafeMutablePointer<Int>?
+) -> Int32 {
+    guard let core, let response, let responseSize, request != nil || requestSize == 0 else {
+        return -1
+    }
+    let requestData = request.map { Data(bytes: $0, count: requestSize) } ?? Data()
+    let responseData = Unmanaged<InProcessCore>.fromOpaque(core).takeUnretainedValue()
+        .transact(requestData)
+    guard !responseData.isEmpty else {
+        return -1
+    }
+    guard let buffer = malloc(responseData.count)?.assumingMemoryBound(to: UInt8.self) else {
+        return -1
+    }
+    responseData.copyBytes(to: buffer, count: responseData.count)
+    response.pointee = buffer
+    responseSize.pointee = responseData.count
+    return 0
+}
+
+@_cdecl("hazkey_core_free")
+public func hazkeyCoreFree(_ response: UnsafeMutablePointer<UInt8>?) {
+    free(response)
+}
+
+@_cdecl("hazkey_core_destroy")
+public func hazkeyCoreDestroy(_ core: UnsafeMutableRawPointer?) {
+    guard let core else {
+        return
+    }
+    let instance = Unmanaged<InProcessCore>.fromOpaque(core)
+    instance.takeUnretainedValue().shutdown()
+    instance.release()
+}
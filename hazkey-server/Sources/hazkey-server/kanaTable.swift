@@ -0,0 +1,124 @@
+import Foundation
+
+/// Table-driven versions of the ICU transforms behind the katakana and
+/// alphabet conversions.
+///
+/// `applyingTransform` goes through an ICU transliterator, which is slow on
+/// Linux, for text that is almost always kana, ASCII and a little
+/// punctuation. The tables map these per code point, decomposing voiced
+/// katakana into a base and a halfwidth sound mark like ICU does. A string
+/// with a character the tables do not model exactly, such as a halfwidth
+/// Hangul form or a bare combining sound mark, is passed to ICU as a whole.
+enum KanaTable {
+    static func hiraganaToKatakana(_ text: String) -> String {
+        var result = String.UnicodeScalarView()
+        for scalar in text.unicodeScalars {
+            switch scalar.value {
+            case 0x3041...0x3094, 0x309D...0x309E:
+                result.append(Unicode.Scalar(scalar.value + 0x60)!)
+            case 0x00...0xFF, 0x3000...0x3029, 0x3030...0x3098, 0x309B...0x309C,
+                0x30A0...0x30FE, 0xFF01...0xFF60, 0xFFE0...0xFFEE:
+                // ICU leaves these alone, including ゕ and ゖ
+                result.append(scalar)
+            default:
+                // ICU normalizes the rest: it composes わ゙, widens halfwidth
+                // katakana, expands ゟ and ヿ and reorders combining marks
+                return text.applyingTransform(.hiraganaToKatakana, reverse: false) ?? text
+            }
+        }
+        return String(result)
+    }
+
+    static func fullwidthToHalfwidth(_ text: String) -> String {
+        var result = String.UnicodeScalarView()
+        for scalar in text.unicodeScalars {
+            if scalar.isASCII {
+                result.append(scalar)
+            } else if let halfwidth = halfwidthForms[scalar.value] {
+                result.append(contentsOf: halfwidth.unicodeScalars)
+            } else if needsICUForHalfwidth(scalar.value) {
+                return text.applyingTransform(.fullwidthToHalfwidth, reverse: false) ?? text
+            } else {
+                result.append(scalar)
+            }
+        }
+        return String(result)
+    }
+
+    /// Only ASCII is mapped here; romaji input rarely has anything else.
+    static func halfwidthToFullwidth(_ text: String) -> String {
+        var result = String.UnicodeScalarView()
+        for scalar in text.unicodeScalars {
+            switch scalar.value {
+            case 0x20:
+                result.append("\u{3000}")
+            case 0x21...0x7E:
+                result.append(Unicode.Scalar(scalar.value + 0xFEE0)!)
+            case 0x00...0x1F, 0x7F:
+                result.append(scalar)
+            default:
+                return text.applyingTransform(.fullwidthToHalfwidth, reverse: true) ?? text
+            }
+        }
+        return String(result)
+    }
+
+    // Sources of the halfwidth katakana and punctuation U+FF61...U+FF9F, in
+    // order.
+    private static let narrowKanaSources: [UInt32] = [
+        0x3002, 0x300C, 0x300D, 0x3001, 0x30FB, 0x30F2, 0x30A1, 0x30A3,
+        0x30A5, 0x30A7, 0x30A9, 0x30E3, 0x30E5, 0x30E7, 0x30C3, 0x30FC,
+        0x30A2, 0x30A4, 0x30A6, 0x30A8, 0x30AA, 0x30AB, 0x30AD, 0x30AF,
+        0x30B1, 0x30B3, 0x30B5, 0x30B7, 0x30B9, 0x30BB, 0x30BD, 0x30BF,
+        0x30C1, 0x30C4, 0x30C6, 0x30C8, 0x30CA, 0x30CB, 0x30CC, 0x30CD,
+        0x30CE, 0x30CF, 0x30D2, 0x30D5, 0x30D8, 0x30DB, 0x30DE, 0x30DF,
+        0x30E0, 0x30E1, 0x30E2, 0x30E4, 0x30E6, 0x30E8, 0x30E9, 0x30EA,
+        0x30EB, 0x30EC, 0x30ED, 0x30EF, 0x30F3, 0x3099, 0x309A,
+    ]
+
+    // Fullwidth signs other than ASCII and their halfwidth forms.
+    private static let wideSigns: [(UInt32, UInt32)] = [
+        (0x3000, 0x0020), (0xFFE0, 0x00A2), (0xFFE1, 0x00A3),
+        (0xFFE2, 0x00AC), (0xFFE3, 0x00AF), (0xFFE4, 0x00A6),
+        (0xFFE5, 0x00A5), (0xFFE6, 0x20A9),
+    ]
+
+    private static let halfwidthForms: [UInt32: String] = {
+        var forms: [UInt32: String] = [:]
+        for value in UInt32(0xFF01)...0xFF5E {
+            forms[value] = String(Unicode.Scalar(value - 0xFEE0)!)
+        }
+        for (wide, narrow) in wideSigns {
+            forms[wide] = String(Unicode.Scalar(narrow)!)
+        }
+        for (offset, source) in narrowKanaSources.enumerated() {
+            forms[source] = String(Unicode.Scalar(0xFF61 + UInt32(offset))!)
+        }
+        // ガ -> ｶﾞ, パ -> ﾊﾟ, ヴ -> ｳﾞ, ...
+        for value in UInt32(0x30A0)...0x30FF where forms[value] == nil {
+            let decomposed = String(Unicode.Scalar(value)!)
+                .decomposedStringWithCanonicalMapping.unicodeScalars.map { $0.value }
+            if decomposed.count == 2, let base = forms[decomposed[0]],
+                let mark = forms[decomposed[1]]
+            {
+                forms[value] = base + mark
+            }
+        }
+        return forms
+    }()
+
+    // Characters ICU changes in ways the table does not follow: voiced
+    // katakana without a halfwidth base, the spacing sound marks, and the
+    // Hangul and symbol blocks that have halfwidth forms. ICU keeps ⦅ and ⦆
+    // fullwidth, so they are not in the table either.
+    private static func needsICUForHalfwidth(_ value: UInt32) -> Bool {
+        switch value {
+        case 0x309B, 0x309C, 0x30F8, 0x30F9, 0x30FE:
+            return true
+        case 0x1100...0x11FF, 0x2190...0x25FF, 0x3130...0x318F:
+            return true
+        default:
+            return false
+        }
+    }
+}
@@ -0,0 +1,249 @@
+import Foundation
+import KanaKanjiConverterModule
+
+/// Background persistence of learning data.
+///
+/// `commitUpdateLearningData()` rewrites the converter's memory files, which is
+/// too slow for the request path, and everything learned since the last commit
+/// is lost when the server is killed. Instead, every learned candidate is
+/// appended to a journal, and commits run coalesced on a background queue.
+/// After a commit the journal is compacted to the entries learned after it.
+/// Entries left over from a crash are replayed on the next start.
+final class LearningPersistence {
+    private struct Entry: Codable {
+        struct Element: Codable {
+            var word: String
+            var ruby: String
+            var lcid: Int
+            var rcid: Int
+            var mid: Int
+            var value: Float
+        }
+        var text: String
+        var value: Float
+        var lastMid: Int
+        var elements: [Element]
+    }
+
+    // journal writes are fsync'ed in batches at most this often
+    private static let syncDelay: DispatchTimeInterval = .seconds(1)
+    // learned candidates are committed at the latest after this delay
+    static let commitDelay: DispatchTimeInterval = .seconds(60)
+
+    private let converter: KanaKanjiConverter
+    private let converterLock: DispatchSemaphore
+    let journalURL: URL
+    private let queue = DispatchQueue(label: "hazkey.learning-persistence", qos: .utility)
+
+    // guarded by converterLock
+    private var nextSequence = 0
+    private var hasUncommitted = false
+    private var pendingReplay: [Entry] = []
+
+    // owned by queue
+    private var journalHandle: FileHandle?
+    private var journaled: [(sequence: Int, line: Data)] = []
+    // entries below this are already in the converter's memory files
+    private var committedBelow = 0
+    private var syncScheduled = false
+    private var commitWorkItem: DispatchWorkItem?
+    private var commitDeadline: DispatchTime?
+
+    init(converter: KanaKanjiConverter, converterLock: DispatchSemaphore, journalURL: URL) {
+        self.converter = converter
+        self.converterLock = converterLock
+        self.journalURL = journalURL
+
+        if let data = try? Data(contentsOf: journalURL) {
+            let decoder = JSONDecoder()
+            for line in data.split(separator: UInt8(ascii: "\n")) {
+                // a torn last line from a crash is simply dropped
+                guard let entry = try? decoder.decode(Entry.self, from: line) else {
+                    continue
+                }
+                pendingReplay.append(entry)
+                journaled.append((nextSequence, Data(line) + [UInt8(ascii: "\n")]))
+                nextSequence += 1
+            }
+            if !pendingReplay.isEmpty {
+                NSLog("Found \(pendingReplay.count) uncommitted learning entries")
+            }
+        }
+        journalHandle = openJournal()
+    }
+
+    /// Journals a candidate passed to `converter.updateLearningData()`.
+    /// Must be called with `converterLock` held.
+    func record(_ candidate: Candidate) {
+        let entry = Entry(
+            text: candidate.text,
+            value: Float(candidate.value),
+            lastMid: candidate.lastMid,
+            elements: candidate.data.map {
+                Entry.Element(
+                    word: $0.word, ruby: $0.ruby, lcid: $0.lcid, rcid: $0.rcid, mid: $0.mid,
+                    value: Float($0.value()))
+            })
+        guard var line = try? JSONEncoder().encode(entry) else {
+            return
+        }
+        line.append(UInt8(ascii: "\n"))
+
+        let sequence = nextSequence
+        nextSequence += 1
+        hasUncommitted = true
+        queue.async {
+            self.append(sequence: sequence, line: line)
+        }
+        requestCommit(after: Self.commitDelay)
+    }
+
+    /// Feeds entries left by a previous run back into the converter. The
+    /// converter must have received request options first, so this is called
+    /// after a conversion. Must be called with `converterLock` held.
+    func replayIfNeeded() {
+        guard !pendingReplay.isEmpty else {
+            return
+        }
+        for entry in pendingReplay {
+            converter.updateLearningData(
+                Candidate(
+                    text: entry.text,
+                    value: PValue(entry.value),
+                    // not used for learning
+                    composingCount: .inputCount(0),
+                    lastMid: entry.lastMid,
+                    data: entry.elements.map {
+                        DicdataElement(
+                            word: $0.word, ruby: $0.ruby, lcid: $0.lcid, rcid: $0.rcid,
+                            mid: $0.mid, value: PValue($0.value))
+                    }))
+        }
+        NSLog("Replayed \(pendingReplay.count) learning entries")
+        pendingReplay = []
+        hasUncommitted = true
+        requestCommit()
+    }
+
+    /// Forgets everything journaled so far, after the converter memory was
+    /// reset. Must be called with `converterLock` held.
+    func discard() {
+        pendingReplay = []
+        hasUncommitted = false
+        let sequence = nextSequence
+        queue.async {
+            self.compact(keepingFrom: sequence)
+        }
+    }
+
+    /// Schedules a commit. Requests are coalesced into the earliest deadline.
+    func requestCommit(after delay: DispatchTimeInterval = .seconds(0)) {
+        queue.async {
+            let deadline = DispatchTime.now() + delay
+            if let scheduled = self.commitDeadline, scheduled <= deadline {
+                return
+            }
+            self.commitWorkItem?.cancel()
+            let workItem = DispatchWorkItem {
+                self.commitWorkItem = nil
+                self.commitDeadline = nil
+                self.commit()
+            }
+            self.commitWorkItem = workItem
+            self.commitDeadline = deadline
+            self.queue.asyncAfter(deadline: deadline, execute: workItem)
+        }
+    }
+
+    /// Commits synchronously. Used at shutdown.
+    func flush() {
+        queue.sync {
+            commitWorkItem?.cancel()
+            commitWorkItem = nil
+            commitDeadline = nil
+            commit()
+        }
+    }
+
+    private func commit() {
+        converterLock.wait()
+        if hasUncommitted {
+            converter.commitUpdateLearningData()
+            hasUncommitted = false
+        }
+        // unreplayed entries are not in the converter yet, keep all of them
+        let committedBelow = pendingReplay.isEmpty ? nextSequence : 0
+        converterLock.signal()
+        compact(keepingFrom: committedBelow)
+    }
+
+    private func append(sequence: Int, line: Data) {
+        // learned before a commit that overtook this write
+        guard sequence >= committedBelow else {
+            return
+        }
+        journaled.append((sequence, line))
+        do {
+            try journalHandle?.write(contentsOf: line)
+        } catch {
+            NSLog("Failed to write learning journal: \(error.localizedDescription)")
+        }
+        guard !syncScheduled else {
+            return
+        }
+        syncScheduled = true
+        queue.asyncAfter(deadline: .now() + Self.syncDelay) {
+            self.syncScheduled = false
+            try? self.journalHandle?.synchronize()
+        }
+    }
+
+    // Rewrites the journal with the entries from `sequence` on. The new journal
+    // is written next to the old one and renamed over it, so a crash leaves
+    // one of the two intact.
+    private func compact(keepingFrom sequence: Int) {
+        committedBelow = max(committedBelow, sequence)
+        let kept = journaled.filter { $0.sequence >= sequence }
+        guard kept.count != journaled.count else {
+            return
+        }
+        let tempURL = journalURL.appendingPathExtension("tmp")
+        do {
+            guard
+                FileManager.default.createFile(
+                    atPath: tempURL.path, contents: kept.reduce(into: Data()) { $0 += $1.line })
+            else {
+                throw CocoaError(.fileWriteUnknown)
+            }
+            let tempHandle = try FileHandle(forWritingTo: tempURL)
+            try tempHandle.synchronize()
+            try tempHandle.close()
+            guard rename(tempURL.path, journalURL.path) == 0 else {
+                throw CocoaError(.fileWriteUnknown)
+            }
+        } catch {
+            NSLog("Failed to compact learning journal: \(error.localizedDescription)")
+            return
+        }
+        try? journalHandle?.close()
+        journalHandle = openJournal()
+        journaled = kept
+    }
+
+    private func openJournal() -> FileHandle? {
+        if !FileManager.default.fileExists(atPath: journalURL.path) {
+            FileManager.default.createFile(atPath: journalURL.path, contents: nil)
+        }
+        do {
+            let handle = try FileHandle(forWritingTo: journalURL)
+            _ = try handle.seekToEnd()
+            return handle
+        } catch {
+            NSLog("Failed to open learning journal: \(error.localizedDescription)")
+            return nil
+        }
+    }
+}
+
+// Converter state is guarded by `converterLock`, the rest by `queue`.
+extension LearningPersistence: @unchecked Sendable {}
@@ -6,6 +6,8 @@ class ProcessManager {
     private let pidFilePath: String
     private let infoFilePath: String
     private var replaceExisting: Bool = false
+    private(set) var warmUpEnabled: Bool = true
+    private(set) var benchmarkStartup: Bool = false
 
     init() {
         self.uid = getuid()
@@ -20,8 +22,14 @@ class ProcessManager {
     func parseCommandLineArguments() {
         let arguments = CommandLine.arguments
         for arg in arguments {
-            if arg == "-r" || arg == "--replace" {
+            switch arg {
+            case "-r", "--replace":
                 replaceExisting = true
+            case "--no-warmup":
+                warmUpEnabled = false
+            case "--benchmark-startup":
+                benchmarkStartup = true
+            default:
                 break
             }
         }
@@ -58,6 +66,21 @@ class ProcessManager {
         }
     }
 
+    // Stops a hazkey-server left running, for a converter that takes over its
+    // socket without exiting like checkExistingServer() does.
+    func terminateRunningServer() {
+        guard let pidString = try? String(contentsOfFile: pidFilePath, encoding: .utf8),
+            let pid = pid_t(pidString), pid != getpid()
+        else {
+            return
+        }
+        if kill(pid, 0) == 0 && !terminateExistingServer(pid: pid) {
+            NSLog("Failed to terminate existing server")
+            return
+        }
+        removePidFile()
+    }
+
     func createPidFile() throws {
         if !FileManager.default.fileExists(atPath: runtimeDir.path) {
             try FileManager.default.createDirectory(
@@ -2,7 +2,18 @@ import Foundation
 import SwiftProtobuf
 
 class ProtocolHandler {
+    /// Hello feature bits this server implements.
+    static let supportedFeatures: UInt64 =
+        UInt64(Hazkey_Commands_Hello.Feature.batch.rawValue)
+        | UInt64(Hazkey_Commands_Hello.Feature.benchmark.rawValue)
+        | UInt64(Hazkey_Commands_Hello.Feature.compactCandidates.rawValue)
+        | UInt64(Hazkey_Commands_Hello.Feature.liveText.rawValue)
+        | UInt64(Hazkey_Commands_Hello.Feature.composingVariants.rawValue)
+        | UInt64(Hazkey_Commands_Hello.Feature.clientSubInput.rawValue)
+
     private let state: HazkeyServerState
+    // features both sides support, from the connected client's Hello
+    private(set) var peerFeatures: UInt64 = 0
 
     init(state: HazkeyServerState) {
         self.state = state
@@ -23,14 +34,30 @@ class ProtocolHandler {
             return serializeResult(unserialized: response)
         }
 
+        let requestStart = DispatchTime.now()
+        let tracer = TraceWriter.shared
+        tracer.currentTraceId = query.traceID
+        let traceStart = tracer.enabled ? TraceWriter.now() : 0
+        defer {
+            let command = Self.commandName(query.payload)
+            state.stats.recordCommand(command, since: requestStart)
+            if tracer.enabled {
+                tracer.writeSpan(
+                    command, category: "server", start: traceStart, end: TraceWriter.now())
+            }
+        }
+
         switch query.payload {
+        case .hello(let req):
+            response = hello(req)
         case .setContext(let req):
             response = state.setContext(
-                surroundingText: req.context, anchorIndex: Int(req.anchor))
+                surroundingText: req.context, anchorIndex: Int(req.anchor),
+                windowLength: Int(req.windowLength))
         case .newComposingText:
             response = state.createComposingTextInstanse()
         case .inputChar(let req):
-            response = state.inputChar(inputString: req.text)
+            response = state.inputChar(inputString: req.text, direct: req.direct)
         case .modifierEvent(let req):
             response = state.processModifierEvent(modifier: req.modType, event: req.eventType)
         case .deleteLeft:
@@ -46,12 +73,27 @@ class ProtocolHandler {
         case .getComposingString(let req):
             response = state.getComposingString(
                 charType: req.charType, currentPreedit: req.currentPreedit)
+        case .getComposingVariants:
+            response = state.getComposingVariants()
         case .getCandidates(let req):
-            response = state.getCandidates(is_suggest: req.isSuggest)
+            response = state.getCandidates(
+                is_suggest: req.isSuggest,
+                compact: peerFeatures
+                    & UInt64(Hazkey_Commands_Hello.Feature.compactCandidates.rawValue) != 0)
+        case .getLiveText:
+            response = state.getLiveText()
         case .getCurrentInputMode:
             response = state.getCurrentInputMode()
         case .saveLearningData:
             response = state.saveLearningData()
+        case .getServerStatus:
+            response = state.getServerStatus()
+        case .getStats:
+            response = state.getStats()
+        case .convertBatch(let req):
+            response = state.convertBatch(req)
+        case .runBenchmark(let req):
+            response = state.runBenchmark(req)
         case .getConfig:
             response = state.serverConfig.getCurrentConfig()
         case .setConfig(let req):
@@ -80,6 +122,39 @@ class ProtocolHandler {
         return serializeResult(unserialized: response)
     }
 
+    /// Called when a new client connects; it has to say Hello again.
+    func resetPeer() {
+        peerFeatures = 0
+    }
+
+    private func hello(_ request: Hazkey_Commands_Hello) -> Hazkey_ResponseEnvelope {
+        peerFeatures = request.features & Self.supportedFeatures
+        NSLog(
+            "Client hello: version \(request.version), protocol \(request.protocolVersion), features \(peerFeatures)"
+        )
+        return Hazkey_ResponseEnvelope.with {
+            $0.status = .success
+            $0.helloResult = Hazkey_Commands_HelloResult.with {
+                $0.protocolVersion = hazkeyProtocolVersion
+                $0.features = peerFeatures
+                $0.version = hazkeyVersion
+                if peerFeatures & UInt64(Hazkey_Commands_Hello.Feature.clientSubInput.rawValue) != 0 {
+                    $0.submodeEntryPointChars =
+                        state.serverConfig.currentProfile.submodeEntryPointChars
+                }
+            }
+        }
+    }
+
+    // "getCandidates" for .getCandidates(...)
+    private static func commandName(_ payload: Hazkey_RequestEnvelope.OneOf_Payload?) -> String {
+        guard let payload else {
+            return "none"
+        }
+        let description = String(describing: payload)
+        return String(description.prefix { $0 != "(" })
+    }
+
     private func serializeResult(unserialized: Hazkey_ResponseEnvelope) -> Data {
         do {
             let serialized = try unserialized.serializedData()
@@ -2,7 +2,7 @@ import Dispatch
 import Foundation
 import KanaKanjiConverterModule
 
-class HazkeyServer: SocketManagerDelegate {
+package class HazkeyServer: SocketManagerDelegate {
     private let processManager: ProcessManager
     private let socketManager: SocketManager
     private let protocolHandler: ProtocolHandler
@@ -12,18 +12,22 @@ class HazkeyServer: SocketManagerDelegate {
     private let uid: uid_t
     private let socketPath: String
 
-    init() {
+    private let stateInitTime: TimeInterval
+
+    package init() {
         // Initialize runtime paths
         self.runtimeDir = ProcessInfo.processInfo.environment["XDG_RUNTIME_DIR"] ?? "/tmp"
         self.uid = getuid()
-        self.socketPath = "\(runtimeDir)/hazkey-server.\(uid).sock"
+        self.socketPath = Self.defaultSocketPath(runtimeDir: runtimeDir, uid: uid)
 
         // Initialize managers
         self.processManager = ProcessManager()
         self.socketManager = SocketManager(socketPath: socketPath)
 
         // Initialize server state
+        let stateInitStart = Date()
         self.state = HazkeyServerState()
+        self.stateInitTime = Date().timeIntervalSince(stateInitStart)
 
         self.protocolHandler = ProtocolHandler(state: state)
 
@@ -31,33 +35,83 @@ class HazkeyServer: SocketManagerDelegate {
         socketManager.delegate = self
     }
 
-    func start() throws {
+    static func defaultSocketPath(
+        runtimeDir: String = ProcessInfo.processInfo.environment["XDG_RUNTIME_DIR"] ?? "/tmp",
+        uid: uid_t = getuid()
+    ) -> String {
+        return "\(runtimeDir)/hazkey-server.\(uid).sock"
+    }
+
+    package func start() throws {
         processManager.parseCommandLineArguments()
+        if processManager.benchmarkStartup {
+            runStartupBenchmark()
+            return
+        }
         try processManager.checkExistingServer()
+        TraceWriter.shared.nameProcess("hazkey-server")
         try socketManager.setupSocket()
         // ソケット失敗した時にpid fileが残るのを防止
         // 必ずsocket->pidの順番で実行する
         try processManager.createPidFile()
         try? processManager.createInfoFile()  // less important
+        if processManager.warmUpEnabled {
+            state.startWarmUp()
+        }
         NSLog("start listening...")
         // DispatchQueue.global(qos: .userInitiated).async {
             socketManager.startListening()
         // }
 
-        let _ = state.saveLearningData()
+        state.learningPersistence.flush()
+        HazkeyServerConfig.waitForPendingWrites()
 
         // Leave them to stabilize
         // processManager.removeInfoFile()
         // processManager.removePidFile()
     }
 
+    // Measure the time from server start to the first suggestion, without
+    // touching the socket, so it can run next to a live server.
+    private func runStartupBenchmark() {
+        let warmUpStart = Date()
+        if processManager.warmUpEnabled {
+            let warmUpDone = DispatchSemaphore(value: 0)
+            state.startWarmUp {
+                warmUpDone.signal()
+            }
+            warmUpDone.wait()
+        }
+        let warmUpTime = Date().timeIntervalSince(warmUpStart)
+
+        let firstCandidateStart = Date()
+        _ = state.createComposingTextInstanse()
+        for char in "kyouhaiitenkidesune" {
+            _ = state.inputChar(inputString: String(char))
+        }
+        let response = state.getCandidates(is_suggest: true)
+        let firstCandidateTime = Date().timeIntervalSince(firstCandidateStart)
+
+        func ms(_ interval: TimeInterval) -> String {
+            return String(format: "%.1f ms", interval * 1000)
+        }
+        print("warm-up: \(processManager.warmUpEnabled ? "enabled" : "disabled")")
+        print("state init: \(ms(stateInitTime))")
+        print("warm-up time: \(ms(warmUpTime))")
+        print("first candidate: \(ms(firstCandidateTime))")
+        print("time to first candidate: \(ms(stateInitTime + warmUpTime + firstCandidateTime))")
+        print("top candidate: \(response.candidates.candidates.first?.text ?? "(none)")")
+    }
+
     func socketManager(_ manager: SocketManager, didReceiveData data: Data, from clientFd: Int32)
         -> Data
     {
         return protocolHandler.processProto(data: data)
     }
 
-    func socketManager(_ manager: SocketManager, clientDidConnect clientFd: Int32) {}
+    func socketManager(_ manager: SocketManager, clientDidConnect clientFd: Int32) {
+        protocolHandler.resetPeer()
+    }
 
     func socketManager(_ manager: SocketManager, clientDidDisconnect clientFd: Int32) {}
 }
@@ -0,0 +1,131 @@
+import Foundation
+
+/// Request timing and resource counters reported by GetStats.
+///
+/// Only touched from the request loop, so it needs no locking. Warm-up runs
+/// on another queue and is reported by GetServerStatus instead.
+final class ServerStats {
+    private struct CommandCounter {
+        var count: Int64 = 0
+        var totalUs: Int64 = 0
+        var maxUs: Int64 = 0
+        var histogram = [Int64](repeating: 0, count: ServerStats.histogramBoundsUs.count + 1)
+    }
+
+    private struct CacheCounter {
+        var hits: Int64 = 0
+        var lookups: Int64 = 0
+    }
+
+    // upper bounds of the latency buckets; one more bucket holds the rest
+    static let histogramBoundsUs: [Int64] = [
+        100, 250, 500, 1_000, 2_500, 5_000, 10_000, 25_000, 50_000, 100_000, 250_000,
+    ]
+
+    private let startTime = Date()
+    private var commands: [String: CommandCounter] = [:]
+    private var caches: [String: CacheCounter] = [:]
+    private var latticeConversions: Int64 = 0
+    private var latticeTimeUs: Int64 = 0
+    private var zenzaiConversions: Int64 = 0
+    private var zenzaiTimeUs: Int64 = 0
+
+    func recordCommand(_ command: String, since start: DispatchTime) {
+        let elapsedUs = Self.microseconds(since: start)
+        var counter = commands[command] ?? CommandCounter()
+        counter.count += 1
+        counter.totalUs += elapsedUs
+        counter.maxUs = max(counter.maxUs, elapsedUs)
+        let bucket =
+            Self.histogramBoundsUs.firstIndex { elapsedUs <= $0 } ?? Self.histogramBoundsUs.count
+        counter.histogram[bucket] += 1
+        commands[command] = counter
+    }
+
+    /// Records one `requestCandidates` call. The converter runs the lattice
+    /// search and Zenzai in one call, so conversions are split by whether
+    /// Zenzai took part rather than by phase.
+    func recordConversion(zenzai: Bool, since start: DispatchTime) {
+        let elapsedUs = Self.microseconds(since: start)
+        if zenzai {
+            zenzaiConversions += 1
+            zenzaiTimeUs += elapsedUs
+        } else {
+            latticeConversions += 1
+            latticeTimeUs += elapsedUs
+        }
+    }
+
+    func recordCacheLookup(_ cache: String, hit: Bool) {
+        var counter = caches[cache] ?? CacheCounter()
+        counter.lookups += 1
+        if hit {
+            counter.hits += 1
+        }
+        caches[cache] = counter
+    }
+
+    func snapshot() -> Hazkey_Commands_ServerStats {
+        return Hazkey_Commands_ServerStats.with {
+            $0.commands = commands.sorted { $0.key < $1.key }.map { command, counter in
+                Hazkey_Commands_ServerStats.CommandStats.with {
+                    $0.command = command
+                    $0.count = counter.count
+                    $0.totalUs = counter.totalUs
+                    $0.maxUs = counter.maxUs
+                    $0.histogram = counter.histogram
+                }
+            }
+            $0.histogramBoundsUs = Self.histogramBoundsUs
+            $0.latticeConversions = latticeConversions
+            $0.latticeTimeUs = latticeTimeUs
+            $0.zenzaiConversions = zenzaiConversions
+            $0.zenzaiTimeUs = zenzaiTimeUs
+            $0.caches = caches.sorted { $0.key < $1.key }.map { name, counter in
+                Hazkey_Commands_ServerStats.CacheStats.with {
+                    $0.name = name
+                    $0.hits = counter.hits
+                    $0.lookups = counter.lookups
+                }
+            }
+            $0.rssBytes = Self.residentSetSize()
+            $0.uptimeMs = Int64(Date().timeIntervalSince(startTime) * 1000)
+        }
+    }
+
+    private static func microseconds(since start: DispatchTime) -> Int64 {
+        return Int64((DispatchTime.now().uptimeNanoseconds - start.uptimeNanoseconds) / 1000)
+    }
+
+    // second field of /proc/self/statm, in pages
+    private static func residentSetSize() -> Int64 {
+        guard let statm = try? String(contentsOfFile: "/proc/self/statm", encoding: .utf8)
+        else {
+            return 0
+        }
+        let fields = statm.split(separator: " ")
+        guard fields.count > 1, let pages = Int64(fields[1]) else {
+            return 0
+        }
+        return pages * Int64(sysconf(Int32(_SC_PAGESIZE)))
+    }
+
+    /// Size of a file, or the total size of the files under a directory.
+    static func diskUsage(_ url: URL) -> Int64 {
+        var isDirectory: ObjCBool = false
+        guard FileManager.default.fileExists(atPath: url.path, isDirectory: &isDirectory) else {
+            return 0
+        }
+        guard isDirectory.boolValue,
+            let enumerator = FileManager.default.enumerator(
+                at: url, includingPropertiesForKeys: [.fileSizeKey])
+        else {
+            return Int64((try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0)
+        }
+        var total: Int64 = 0
+        for case let file as URL in enumerator {
+            total += Int64((try? file.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0)
+        }
+        return total
+    }
+}
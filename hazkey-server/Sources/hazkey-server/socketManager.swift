@@ -17,9 +17,13 @@ class SocketManager {
     private var currentClientFd: Int32?
     private let socketPath: String
     private var pipeFds: [Int32] = [-1, -1]
+    // false when the socket is served from a host process, which keeps its
+    // own SIGINT/SIGTERM/SIGHUP handling
+    private let handlesSignals: Bool
 
-    init(socketPath: String) {
+    init(socketPath: String, handlesSignals: Bool = true) {
         self.socketPath = socketPath
+        self.handlesSignals = handlesSignals
     }
 
     deinit {
@@ -73,6 +77,9 @@ class SocketManager {
 
     private func setupSignalHandlers() {
         signal(SIGPIPE, SIG_IGN)
+        guard handlesSignals else {
+            return
+        }
 
         let signalQueue = DispatchQueue(label: "dev.hiira.hazkey.server.socketmanager.signals")
         let signals = [SIGINT, SIGTERM, SIGHUP]
@@ -81,18 +88,22 @@ class SocketManager {
             let source = DispatchSource.makeSignalSource(signal: sig, queue: signalQueue)
             source.setEventHandler { [weak self] in
                 NSLog("Signal \(sig) received, shutting down...")
-                self?.continueServing = false
-                // stop poll
-                if let pipeFd = self?.pipeFds[1] {
-                    close(pipeFd)
-                    self?.pipeFds[1] = -1
-                }
+                self?.stopListening()
             }
             source.resume()
             self.signalSources.append(source)
         }
     }
 
+    // Makes startListening() return; the pipe wakes up its poll.
+    func stopListening() {
+        continueServing = false
+        if pipeFds[1] != -1 {
+            close(pipeFds[1])
+            pipeFds[1] = -1
+        }
+    }
+
     func startListening() {
         setupSignalHandlers()
         while continueServing {
@@ -176,6 +187,8 @@ class SocketManager {
                 currentClientFd = nil
             } else {
                 currentClientFd = newClientFd
+                // forget what was negotiated with the previous client; the
+                // new one starts with Hello
                 delegate?.socketManager(self, clientDidConnect: newClientFd)
             }
         }
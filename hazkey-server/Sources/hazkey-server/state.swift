@@ -10,21 +10,50 @@ class HazkeyServerState {
 
     var isShiftPressedAlone = false
     var isSubInputMode = false
-    var learningDataNeedsCommit = false
 
     var keymap: Keymap
     var currentTableName: String
     var baseConvertRequestOptions: ConvertRequestOptions
-
-    init() {
-        self.serverConfig = HazkeyServerConfig()
+    // left context baked into baseConvertRequestOptions.zenzaiMode
+    private var zenzaiLeftContext = ""
+    // most characters of left context, from the client's context window
+    private var zenzaiLeftContextLimit = 0
+    private var lastContextRequest: (surroundingText: String, anchorIndex: Int, windowLength: Int)?
+
+    // Serializes use of `converter` between request handling and the warm-up
+    // queue. A semaphore is used because warm-up releases it on another thread.
+    let converterLock = DispatchSemaphore(value: 1)
+    private var warmUpState: Hazkey_Commands_ServerStatus.WarmUpState = .disabled
+    private var warmUpTimeMs: Int64 = 0
+    private var warmUpOptions: ConvertRequestOptions?
+    private var zenzaiLoaded = false
+    // Set while warm-up holds `converterLock`; read without it.
+    private let warmUpFlagLock = NSLock()
+    private var warmUpRunning = false
+
+    let learningPersistence: LearningPersistence
+    let stats: ServerStats
+    // true when loaded into fcitx5 as libhazkey-core
+    let inProcess: Bool
+    private lazy var batchConverter = BatchConverter(dictionaryURL: serverConfig.dictionaryPath)
+    // Converts with profile settings outside the composition, for ConvertBatch
+    // with use_profile and RunBenchmark. Only used from the request loop. It
+    // loads its own Zenzai model on first use, so it is created only when
+    // needed.
+    private lazy var profileConverter = KanaKanjiConverter(
+        dictionaryURL: serverConfig.dictionaryPath)
+
+    init(inProcess: Bool = false) {
+        self.inProcess = inProcess
+        let stats = ServerStats()
+        self.stats = stats
+        self.serverConfig = HazkeyServerConfig(stats: stats)
 
         self.converter = KanaKanjiConverter.init(dictionaryURL: serverConfig.dictionaryPath)
 
         // Initialize keymap and table
         self.keymap = serverConfig.loadKeymap()
-        self.currentTableName = UUID().uuidString
-        serverConfig.loadInputTable(tableName: currentTableName)
+        self.currentTableName = serverConfig.loadInputTable()
 
         // Create user state directories (history data)
         do {
@@ -54,12 +83,41 @@ class HazkeyServerState {
 
         // Initialize base convert options
         self.baseConvertRequestOptions = serverConfig.genBaseConvertRequestOptions()
+
+        self.learningPersistence = LearningPersistence(
+            converter: converter, converterLock: converterLock,
+            journalURL: HazkeyServerConfig.getStateDirectory().appendingPathComponent(
+                "learning_journal.jsonl"))
     }
 
-    func setContext(surroundingText: String, anchorIndex: Int) -> Hazkey_ResponseEnvelope {
-        let leftContext = String(surroundingText.prefix(anchorIndex))
-        baseConvertRequestOptions.zenzaiMode = serverConfig.genZenzaiMode(
-            leftContext: leftContext)
+    func setContext(surroundingText: String, anchorIndex: Int, windowLength: Int)
+        -> Hazkey_ResponseEnvelope
+    {
+        let contextUnchanged =
+            lastContextRequest.map {
+                $0.anchorIndex == anchorIndex && $0.surroundingText == surroundingText
+                    && $0.windowLength == windowLength
+            } ?? false
+        stats.recordCacheLookup("context", hit: contextUnchanged)
+        if contextUnchanged {
+            return Hazkey_ResponseEnvelope.with {
+                $0.status = .success
+            }
+        }
+        lastContextRequest = (surroundingText, anchorIndex, windowLength)
+
+        // fcitx5 counts the anchor in code points, not grapheme clusters
+        let received = String(surroundingText.unicodeScalars.prefix(anchorIndex))
+        // a client that does not send its window may still cut the context
+        zenzaiLeftContextLimit = windowLength > 0 ? windowLength : received.count
+        let leftContext = HazkeyServerConfig.anchoredZenzaiLeftContext(
+            received, previous: zenzaiLeftContext, limit: zenzaiLeftContextLimit)
+        // Keep the same ZenzaiMode (and so the same prompt) when nothing changed.
+        if leftContext != zenzaiLeftContext {
+            baseConvertRequestOptions.zenzaiMode = serverConfig.genZenzaiMode(
+                leftContext: leftContext)
+            zenzaiLeftContext = leftContext
+        }
 
         return Hazkey_ResponseEnvelope.with {
             $0.status = .success
@@ -78,7 +136,12 @@ class HazkeyServerState {
         }
     }
 
-    func inputChar(inputString: String) -> Hazkey_ResponseEnvelope {
+    func inputChar(inputString: String, direct: Bool = false) -> Hazkey_ResponseEnvelope {
+        if direct {
+            // typed in sub-input mode tracked by the client
+            composingText.value.insertAtCursorPosition(inputString, inputStyle: .direct)
+            return Hazkey_ResponseEnvelope.with { $0.status = .success }
+        }
         guard let inputChar = inputString.first else {
             return Hazkey_ResponseEnvelope.with {
                 $0.status = .failed
@@ -150,11 +213,9 @@ class HazkeyServerState {
         }
     }
 
+    // Learning is journaled as it happens, so only schedule the commit here.
     func saveLearningData() -> Hazkey_ResponseEnvelope {
-        if learningDataNeedsCommit {
-            converter.commitUpdateLearningData()
-            learningDataNeedsCommit = false
-        }
+        learningPersistence.requestCommit()
         return Hazkey_ResponseEnvelope.with {
             $0.status = .success
         }
@@ -177,9 +238,11 @@ class HazkeyServerState {
     func completePrefix(candidateIndex: Int) -> Hazkey_ResponseEnvelope {
         if let completedCandidate = currentCandidateList?[candidateIndex] {
             composingText.value.prefixComplete(composingCount: completedCandidate.composingCount)
+            converterLock.wait()
+            defer { converterLock.signal() }
             converter.setCompletedData(completedCandidate)
             converter.updateLearningData(completedCandidate)
-            learningDataNeedsCommit = true
+            learningPersistence.record(completedCandidate)
         } else {
             return Hazkey_ResponseEnvelope.with {
                 $0.status = .failed
@@ -201,25 +264,12 @@ class HazkeyServerState {
     /// ComposingText -> Characters
 
     func getHiraganaWithCursor() -> Hazkey_ResponseEnvelope {
-        func safeSubstring(_ text: String, start: Int, end: Int) -> String {
-            guard start >= 0, end >= 0, start < text.count, end <= text.count, start < end else {
-                return ""
-            }
-
-            let startIndex = text.index(text.startIndex, offsetBy: start)
-            let endIndex = text.index(text.startIndex, offsetBy: end)
-
-            return String(text[startIndex..<endIndex])
-        }
-
-        let hiragana = composingText.value.toHiragana()
-        let cursorPos = composingText.value.convertTargetCursorPosition
-
         if (serverConfig.currentProfile.auxTextMode
             == Hazkey_Config_Profile.AuxTextMode.auxTextDisabled)
             || (serverConfig.currentProfile.auxTextMode
                 == Hazkey_Config_Profile.AuxTextMode.auxTextShowWhenCursorNotAtEnd
-                && hiragana.count == cursorPos)
+                && composingText.hiraganaCount
+                    == composingText.value.convertTargetCursorPosition)
         {
             return Hazkey_ResponseEnvelope.with {
                 $0.status = .success
@@ -231,12 +281,13 @@ class HazkeyServerState {
             }
         }
 
+        let split = composingText.cursorSplit
         return Hazkey_ResponseEnvelope.with {
             $0.status = .success
             $0.textWithCursor = Hazkey_Commands_TextWithCursor.with {
-                $0.beforeCursosr = safeSubstring(hiragana, start: 0, end: cursorPos)
-                $0.onCursor = safeSubstring(hiragana, start: cursorPos, end: cursorPos + 1)
-                $0.afterCursor = safeSubstring(hiragana, start: cursorPos + 1, end: hiragana.count)
+                $0.beforeCursosr = split.beforeCursor
+                $0.onCursor = split.onCursor
+                $0.afterCursor = split.afterCursor
             }
         }
     }
@@ -248,17 +299,17 @@ class HazkeyServerState {
         let result: String
         switch charType {
         case .hiragana:
-            result = composingText.value.toHiragana()
+            result = composingText.hiragana
         case .katakanaFull:
-            result = composingText.value.toKatakana(true)
+            result = composingText.katakana(fullWidth: true)
         case .katakanaHalf:
-            result = composingText.value.toKatakana(false)
+            result = composingText.katakana(fullWidth: false)
         case .alphabetFull:
             result = cycleAlphabetCase(
-                composingText.value.toAlphabet(true), preedit: currentPreedit)
+                composingText.alphabet(fullWidth: true), preedit: currentPreedit)
         case .alphabetHalf:
             result = cycleAlphabetCase(
-                composingText.value.toAlphabet(false), preedit: currentPreedit)
+                composingText.alphabet(fullWidth: false), preedit: currentPreedit)
         case .UNRECOGNIZED:
             return Hazkey_ResponseEnvelope.with {
                 $0.status = .failed
@@ -271,16 +322,33 @@ class HazkeyServerState {
         }
     }
 
+    func getComposingVariants() -> Hazkey_ResponseEnvelope {
+        return Hazkey_ResponseEnvelope.with {
+            $0.status = .success
+            $0.composingVariants = Hazkey_Commands_ComposingVariants.with {
+                $0.hiragana = composingText.hiragana
+                $0.katakanaFull = composingText.katakana(fullWidth: true)
+                $0.katakanaHalf = composingText.katakana(fullWidth: false)
+                $0.alphabetFull = alphabetCaseCycle(composingText.alphabet(fullWidth: true))
+                $0.alphabetHalf = alphabetCaseCycle(composingText.alphabet(fullWidth: false))
+            }
+        }
+    }
+
     /// Candidates
 
     // TODO: return error message
-    func getCandidates(is_suggest: Bool) -> Hazkey_ResponseEnvelope {
+    // With `compact`, the reading is sent once and each candidate only says
+    // how much of it it converts; see CandidatesResult in commands.proto.
+    func getCandidates(is_suggest: Bool, compact: Bool = false) -> Hazkey_ResponseEnvelope {
+        guard lockConverterUnlessWarmingUp() else {
+            return warmingUpResponse()
+        }
+        defer { converterLock.signal() }
+
         var options = baseConvertRequestOptions
         options.N_best = {
-            if is_suggest
-                && serverConfig.currentProfile.suggestionListMode
-                    == Hazkey_Config_Profile.SuggestionListMode.suggestionListDisabled
-            {
+            if is_suggest && isSuggestionListDisabled {
                 // for auto conversion
                 return 1
             } else if is_suggest {
@@ -301,7 +369,7 @@ class HazkeyServerState {
 
         if !is_suggest {
             let _ = copiedComposingText.moveCursorFromCursorPosition(
-                count: copiedComposingText.toHiragana().count)
+                count: composingText.hiraganaCount)
             copiedComposingText.insertAtCursorPosition(
                 [
                     ComposingText.InputElement(
@@ -310,49 +378,63 @@ class HazkeyServerState {
                 ])
         }
 
-        let converted = converter.requestCandidates(copiedComposingText, options: options)
+        // the separator can change the reading, e.g. a trailing "n"
+        let hiraganaPreedit =
+            is_suggest ? composingText.hiragana : copiedComposingText.toHiragana()
+        let longInputChunks =
+            is_suggest
+            ? nil
+            : Self.splitLongInput(
+                hiraganaPreedit, chunkLength: serverConfig.longInputChunkLength)
+
+        let conversionStart = DispatchTime.now()
+        let mainResults = TraceWriter.shared.span(
+            "requestCandidates", category: "converter",
+            detail: longInputChunks != nil
+                ? "chunked" : serverConfig.isZenzaiEnabled ? "zenzai" : "lattice"
+        ) {
+            if let longInputChunks,
+                let stitched = convertLongInput(longInputChunks, options: options)
+            {
+                return stitched
+            }
+            return converter.requestCandidates(copiedComposingText, options: options).mainResults
+        }
+        stats.recordConversion(zenzai: serverConfig.isZenzaiEnabled, since: conversionStart)
+        zenzaiLoaded = zenzaiLoaded || serverConfig.isZenzaiEnabled
+        learningPersistence.replayIfNeeded()
 
-        currentCandidateList = converted.mainResults
+        currentCandidateList = mainResults
 
-        let hiraganaPreedit = copiedComposingText.toHiragana()
+        let readingCount = is_suggest ? composingText.hiraganaCount : hiraganaPreedit.count
+        let readingOffsets = compact ? Self.utf8Offsets(hiraganaPreedit) : nil
 
         var candidatesResult = Hazkey_Commands_CandidatesResult()
         candidatesResult.liveTextIndex = -1
-        candidatesResult.candidates = converted.mainResults.enumerated().map { index, c in
+        if compact {
+            candidatesResult.reading = hiraganaPreedit
+        }
+        candidatesResult.candidates = mainResults.map { c in
             var candidate = Hazkey_Commands_CandidatesResult.Candidate()
             candidate.text = c.text
 
-            let endIndex = min(c.rubyCount, hiraganaPreedit.count)
-            candidate.subHiragana = String(hiraganaPreedit.dropFirst(endIndex))
-
-            // Set liveText if conditions are met
-            if candidatesResult.liveText.isEmpty && c.rubyCount == hiraganaPreedit.count {
-                candidatesResult.liveText = c.text
-                candidatesResult.liveTextIndex = Int32(index)
+            let endIndex = min(c.rubyCount, readingCount)
+            if let readingOffsets {
+                candidate.consumedBytes = Int32(readingOffsets[endIndex])
+            } else {
+                candidate.subHiragana = String(hiraganaPreedit.dropFirst(endIndex))
             }
 
             return candidate
         }
 
-        // Do not automatically convert if there is only one character
-        if serverConfig.currentProfile.autoConvertMode
-            == Hazkey_Config_Profile.AutoConvertMode.autoConvertForMultipleChars
-            && hiraganaPreedit.count == 1
-        {
-            candidatesResult.liveText = ""
-            candidatesResult.liveTextIndex = -1
-        } else if serverConfig.currentProfile.autoConvertMode
-            == Hazkey_Config_Profile.AutoConvertMode.autoConvertDisabled
-        {
-            candidatesResult.liveText = ""
-            candidatesResult.liveTextIndex = -1
+        if let liveTextIndex = liveTextIndex(mainResults, readingCount: readingCount) {
+            candidatesResult.liveText = mainResults[liveTextIndex].text
+            candidatesResult.liveTextIndex = Int32(liveTextIndex)
         }
 
         candidatesResult.pageSize = {
-            if is_suggest
-                && serverConfig.currentProfile.suggestionListMode
-                    == Hazkey_Config_Profile.SuggestionListMode.suggestionListDisabled
-            {
+            if is_suggest && isSuggestionListDisabled {
                 return 0
             } else if is_suggest {
                 return serverConfig.currentProfile.numSuggestions
@@ -367,30 +449,467 @@ class HazkeyServerState {
         }
     }
 
+    // Only the best conversion of the whole reading, for the live text shown
+    // on each key stroke: no prediction, no N-best list, and no candidates in
+    // the response. page_size is what getCandidates would report for a
+    // suggestion, so the client knows whether to ask for the list afterwards.
+    func getLiveText() -> Hazkey_ResponseEnvelope {
+        guard lockConverterUnlessWarmingUp() else {
+            return warmingUpResponse()
+        }
+        defer { converterLock.signal() }
+
+        var options = baseConvertRequestOptions
+        options.N_best = 1
+        options.requireJapanesePrediction = .disabled
+        options.requireEnglishPrediction = .disabled
+
+        let hiraganaPreedit = composingText.hiragana
+        let conversionStart = DispatchTime.now()
+        let mainResults = TraceWriter.shared.span(
+            "requestCandidates", category: "converter", detail: "live"
+        ) {
+            converter.requestCandidates(composingText.value, options: options).mainResults
+        }
+        stats.recordConversion(zenzai: serverConfig.isZenzaiEnabled, since: conversionStart)
+        zenzaiLoaded = zenzaiLoaded || serverConfig.isZenzaiEnabled
+        learningPersistence.replayIfNeeded()
+
+        // live_text_index refers to this list when the live text is committed
+        currentCandidateList = mainResults
+
+        var result = Hazkey_Commands_CandidatesResult()
+        result.liveTextIndex = -1
+        if let liveTextIndex = liveTextIndex(mainResults, readingCount: composingText.hiraganaCount) {
+            result.liveText = mainResults[liveTextIndex].text
+            result.liveTextIndex = Int32(liveTextIndex)
+        }
+        result.pageSize = isSuggestionListDisabled ? 0 : serverConfig.currentProfile.numSuggestions
+
+        return Hazkey_ResponseEnvelope.with {
+            $0.status = .success
+            $0.candidates = result
+        }
+    }
+
+    private var isSuggestionListDisabled: Bool {
+        serverConfig.currentProfile.suggestionListMode
+            == Hazkey_Config_Profile.SuggestionListMode.suggestionListDisabled
+    }
+
+    // The first candidate converting the whole reading, unless auto conversion
+    // is off for this reading.
+    private func liveTextIndex(_ results: [Candidate], readingCount: Int) -> Int? {
+        switch serverConfig.currentProfile.autoConvertMode {
+        case .autoConvertDisabled:
+            return nil
+        case .autoConvertForMultipleChars where readingCount == 1:
+            // Do not automatically convert if there is only one character
+            return nil
+        default:
+            return results.firstIndex { $0.rubyCount == readingCount }
+        }
+    }
+
+    // Do not block the client while warm-up is holding the converter, but
+    // wait out anything else, such as a background learning commit, however
+    // long it takes. The warm-up flag is checked before any timed wait, so a
+    // request during warm-up is answered at once.
+    private func lockConverterUnlessWarmingUp() -> Bool {
+        if converterLock.wait(timeout: .now()) == .success {
+            return true
+        }
+        while !isWarmingUp {
+            if converterLock.wait(timeout: .now() + .milliseconds(200)) == .success {
+                return true
+            }
+        }
+        return false
+    }
+
+    private var isWarmingUp: Bool {
+        warmUpFlagLock.lock()
+        defer { warmUpFlagLock.unlock() }
+        return warmUpRunning
+    }
+
+    private func setWarmUpRunning(_ running: Bool) {
+        warmUpFlagLock.lock()
+        defer { warmUpFlagLock.unlock() }
+        warmUpRunning = running
+    }
+
+    private func warmingUpResponse() -> Hazkey_ResponseEnvelope {
+        return Hazkey_ResponseEnvelope.with {
+            $0.status = .success
+            $0.candidates = Hazkey_Commands_CandidatesResult.with {
+                $0.liveTextIndex = -1
+                $0.warmingUp = true
+            }
+        }
+    }
+
+    // UTF-8 offset of every character boundary in `text`, from 0 to its
+    // byte length.
+    private static func utf8Offsets(_ text: String) -> [Int] {
+        var offsets = [0]
+        offsets.reserveCapacity(text.count + 1)
+        var offset = 0
+        for character in text {
+            offset += character.utf8.count
+            offsets.append(offset)
+        }
+        return offsets
+    }
+
+    /// Long input
+
+    private static let chunkBoundariesAfter: Set<Character> = [
+        "、", "。", "，", "．", ",", ".", "！", "？", "!", "?", "…", " ", "　", "」", "』", "）", ")",
+    ]
+    private static let chunkBoundariesBefore: Set<Character> = ["「", "『", "（", "("]
+
+    /// Splits a reading at punctuation and brackets into chunks of up to
+    /// `chunkLength` characters where possible. nil when the reading is short
+    /// enough, chunking is disabled, or there is no boundary to split at.
+    static func splitLongInput(_ reading: String, chunkLength: Int) -> [String]? {
+        guard chunkLength > 0, reading.count > chunkLength else {
+            return nil
+        }
+        var pieces: [String] = []
+        var current = ""
+        for character in reading {
+            if chunkBoundariesBefore.contains(character) && !current.isEmpty {
+                pieces.append(current)
+                current = ""
+            }
+            current.append(character)
+            if chunkBoundariesAfter.contains(character) {
+                pieces.append(current)
+                current = ""
+            }
+        }
+        if !current.isEmpty {
+            pieces.append(current)
+        }
+
+        // join neighbouring pieces, so that the lattice still sees whole phrases
+        var chunks: [String] = []
+        for piece in pieces {
+            if let last = chunks.last, last.count + piece.count <= chunkLength {
+                chunks[chunks.count - 1] += piece
+            } else {
+                chunks.append(piece)
+            }
+        }
+        return chunks.count > 1 ? chunks : nil
+    }
+
+    // Converts a long reading chunk by chunk and stitches the best results
+    // together, so that the cost grows linearly with the length. Without
+    // Zenzai the chunks run in parallel on the batch pool. With Zenzai they
+    // run one after another on `converter`, each seeing the text before it as
+    // left context. nil if a chunk has no full-length candidate. Must be
+    // called with `converterLock` held.
+    private func convertLongInput(_ chunks: [String], options: ConvertRequestOptions)
+        -> [Candidate]?
+    {
+        let chunkCandidates: [[Candidate]]
+        if serverConfig.isZenzaiEnabled {
+            var text = zenzaiLeftContext
+            var leftContext = zenzaiLeftContext
+            var chunkOptions = options
+            chunkCandidates = chunks.map { chunk in
+                leftContext = HazkeyServerConfig.anchoredZenzaiLeftContext(
+                    text, previous: leftContext,
+                    limit: max(zenzaiLeftContextLimit, zenzaiLeftContext.count))
+                chunkOptions.zenzaiMode = serverConfig.genZenzaiMode(leftContext: leftContext)
+                // `converter` serves the composition, so its lattice is kept
+                let candidates = BatchConverter.fullLengthCandidates(
+                    chunk, converter: converter, options: chunkOptions,
+                    endComposition: false)
+                text += candidates.first?.text ?? chunk
+                return candidates
+            }
+        } else {
+            chunkCandidates = batchConverter.convertChunks(chunks, options: options)
+        }
+        guard chunkCandidates.allSatisfy({ !$0.isEmpty }) else {
+            return nil
+        }
+
+        // Chunks were converted from their hiragana, so count the composition
+        // in surface characters rather than in key inputs.
+        let best = chunkCandidates.map { $0[0] }
+        let stitched = Candidate(
+            text: best.map { $0.text }.joined(),
+            value: best.reduce(PValue(0)) { $0 + $1.value },
+            composingCount: .surfaceCount(chunks.reduce(0) { $0 + $1.count }),
+            lastMid: best[best.count - 1].lastMid,
+            data: best.flatMap { $0.data })
+        // alternatives for the first chunk; the rest is converted again after
+        // one of them is chosen
+        let firstChunkAlternatives = chunkCandidates[0].dropFirst()
+            .prefix(max(0, options.N_best - 1))
+            .map {
+                Candidate(
+                    text: $0.text, value: $0.value,
+                    composingCount: .surfaceCount($0.rubyCount),
+                    lastMid: $0.lastMid, data: $0.data)
+            }
+        return [stitched] + firstChunkAlternatives
+    }
+
+    // The batch never touches `converter`, so it neither waits for warm-up
+    // nor blocks it; the request loop is busy until the batch finishes,
+    // though.
+    func convertBatch(_ request: Hazkey_Commands_ConvertBatch) -> Hazkey_ResponseEnvelope {
+        let result =
+            request.useProfile
+            ? convertBatchWithProfile(request)
+            : batchConverter.convert(request, baseOptions: baseConvertRequestOptions)
+        return Hazkey_ResponseEnvelope.with {
+            $0.status = .success
+            $0.batchResult = result
+        }
+    }
+
+    // Used for evaluating profile settings: same options as getCandidates
+    // with the given profile and left context, on `profileConverter`, so the
+    // composition and the interactive converter are left untouched. The
+    // learning data is read but only `converter` updates it.
+    private func convertBatchWithProfile(_ request: Hazkey_Commands_ConvertBatch)
+        -> Hazkey_Commands_BatchResult
+    {
+        let profile = request.hasProfile ? request.profile : serverConfig.currentProfile
+        var options = baseConvertRequestOptions
+        options.N_best =
+            request.nBest > 0 ? Int(request.nBest) : Int(profile.numCandidatesPerPage)
+        options.requireJapanesePrediction = .disabled
+        options.requireEnglishPrediction = .disabled
+        options.learningType =
+            options.learningType == .nothing ? .nothing : .onlyOutput
+
+        let batchStart = DispatchTime.now()
+        let items = request.inputs.enumerated().map { index, input in
+            let leftContext =
+                index < request.leftContexts.count ? request.leftContexts[index] : ""
+            options.zenzaiMode = serverConfig.genZenzaiMode(
+                leftContext: leftContext,
+                profile: profile)
+            return BatchConverter.convertOne(input, converter: profileConverter, options: options)
+        }
+
+        return Hazkey_Commands_BatchResult.with {
+            $0.items = items
+            $0.workers = 1
+            $0.elapsedUs = BatchConverter.microseconds(since: batchStart)
+        }
+    }
+
+    /// Benchmark
+
+    // Typical conversions, from a single word to a sentence, each with the
+    // text typed before it for the contextual mode.
+    private static let benchmarkSamples: [(reading: String, leftContext: String)] = [
+        ("へんかん", ""),
+        ("きょうはいいてんきですね", ""),
+        ("かいぎのしりょうをおくります", "お疲れさまです。"),
+        ("あしたのごごさんじにえきでまちあわせましょう", "了解しました。"),
+        ("このせっていはさいきどうごにはんえいされます", "設定を変更しました。"),
+        ("きしゃのきしゃがきしゃできしゃした", ""),
+        ("にほんごにゅうりょくのせいどをたしかめる", "新しい変換エンジンで"),
+        ("よろしくおねがいします", "以上です。"),
+    ]
+
+    // Runs on `profileConverter` with the same options as getCandidates, so
+    // it neither waits for warm-up nor touches the composition. A request
+    // covers only the samples asked for; see RunBenchmark in commands.proto.
+    func runBenchmark(_ request: Hazkey_Commands_RunBenchmark) -> Hazkey_ResponseEnvelope {
+        var options = baseConvertRequestOptions
+        options.requireJapanesePrediction = .disabled
+        options.requireEnglishPrediction = .disabled
+        options.learningType =
+            options.learningType == .nothing ? .nothing : .onlyOutput
+        let iterations = max(1, Int(request.iterations))
+        let firstSample = min(max(0, Int(request.firstSample)), Self.benchmarkSamples.count)
+        let sampleCount =
+            request.sampleCount > 0
+            ? min(Int(request.sampleCount), Self.benchmarkSamples.count - firstSample)
+            : Self.benchmarkSamples.count - firstSample
+        let samples = Self.benchmarkSamples[firstSample..<(firstSample + sampleCount)]
+
+        let settings = request.settings.map { setting in
+            var profile = serverConfig.currentProfile
+            profile.zenzaiEnable = setting.zenzaiEnable
+            profile.zenzaiInferLimit = max(1, setting.zenzaiInferLimit)
+            profile.zenzaiBackendDeviceName = setting.zenzaiBackendDeviceName
+            profile.zenzaiContextualMode = setting.zenzaiContextualMode
+
+            if request.warmUp, let sample = Self.benchmarkSamples.first {
+                options.zenzaiMode = serverConfig.genZenzaiMode(
+                    leftContext: sample.leftContext, profile: profile)
+                _ = BatchConverter.convertOne(
+                    sample.reading, converter: profileConverter, options: options)
+            }
+            var latencies: [Int64] = []
+            for _ in 0..<iterations {
+                for sample in samples {
+                    options.zenzaiMode = serverConfig.genZenzaiMode(
+                        leftContext: sample.leftContext, profile: profile)
+                    latencies.append(
+                        BatchConverter.convertOne(
+                            sample.reading, converter: profileConverter, options: options
+                        ).latencyUs)
+                }
+            }
+
+            return Hazkey_Commands_BenchmarkResult.Setting.with {
+                $0.latenciesUs = latencies
+                $0.zenzaiUsed =
+                    serverConfig.zenzaiAvailable && serverConfig.zenzaiModelPath != nil
+                    && profile.zenzaiEnable
+            }
+        }
+
+        return Hazkey_ResponseEnvelope.with {
+            $0.status = .success
+            $0.benchmarkResult = Hazkey_Commands_BenchmarkResult.with {
+                $0.settings = settings
+                $0.sampleSetSize = Int32(Self.benchmarkSamples.count)
+            }
+        }
+    }
+
     func clearProfileLearningData() -> Hazkey_ResponseEnvelope {
+        converterLock.wait()
+        defer { converterLock.signal() }
         converter.resetMemory()
+        learningPersistence.discard()
         return Hazkey_ResponseEnvelope.with {
             $0.status = .success
         }
     }
 
-    func reinitializeConfiguration() {
-        NSLog("Reinitializing state configuration...")
+    // Applies a profile change to the affected subsystems only, so that the
+    // current composition survives unrelated settings changes.
+    func applyConfigChanges(_ changes: HazkeyServerConfig.ConfigChanges) {
+        NSLog("Applying configuration changes: \(changes.rawValue)")
 
-        self.keymap = serverConfig.loadKeymap()
+        if changes.contains(.keymaps) {
+            self.keymap = serverConfig.loadKeymap()
+        }
 
-        let newTableName = UUID().uuidString
-        serverConfig.loadInputTable(tableName: newTableName)
-        self.currentTableName = newTableName
+        if changes.contains(.inputTables) {
+            let newTableName = serverConfig.loadInputTable()
+            if newTableName != currentTableName {
+                // composing text refers to the replaced table
+                self.currentTableName = newTableName
+                self.composingText = ComposingTextBox()
+                self.currentCandidateList = nil
+                self.isSubInputMode = false
+                self.isShiftPressedAlone = false
+            }
+        }
 
-        self.baseConvertRequestOptions = serverConfig.genBaseConvertRequestOptions()
+        if changes.contains(.candidateCount) {
+            baseConvertRequestOptions.N_best = Int(serverConfig.currentProfile.numCandidatesPerPage)
+        }
+        if changes.contains(.learning) {
+            baseConvertRequestOptions.learningType = serverConfig.genLearningType()
+        }
+        if changes.contains(.specialProviders) {
+            baseConvertRequestOptions.specialCandidateProviders =
+                serverConfig.genSpecialCandidateProviders()
+        }
+        if changes.contains(.zenzai) {
+            // the client only resends context when it changes, so keep the current one
+            baseConvertRequestOptions.zenzaiMode = serverConfig.genZenzaiMode(
+                leftContext: zenzaiLeftContext)
+        }
+    }
+
+    /// Warm-up
 
-        self.composingText = ComposingTextBox()
-        self.currentCandidateList = nil
-        self.isSubInputMode = false
-        self.isShiftPressedAlone = false
+    // Preload the dictionary and the Zenzai model on a background queue, so the
+    // first key stroke after login does not stall. The converter lock is taken
+    // here, before any request can be served, and released when warm-up ends.
+    func startWarmUp(completion: (@Sendable () -> Void)? = nil) {
+        var options = baseConvertRequestOptions
+        options.N_best = 1
+        options.preloadDictionary = true
+        converterLock.wait()
+        warmUpOptions = options
+        warmUpState = .warmingUp
+        setWarmUpRunning(true)
+        DispatchQueue.global(qos: .userInitiated).async {
+            self.runWarmUp()
+            self.setWarmUpRunning(false)
+            self.converterLock.signal()
+            completion?()
+        }
+    }
+
+    private func runWarmUp() {
+        guard let options = warmUpOptions else {
+            return
+        }
+        NSLog("Warming up converter...")
+        let startTime = Date()
+
+        // Running a real conversion loads every dictionary shard and, if
+        // enabled, the Zenzai weights and its first inference.
+        var dummyText = ComposingText()
+        dummyText.insertAtCursorPosition("へんかん", inputStyle: .direct)
+        _ = converter.requestCandidates(dummyText, options: options)
+        converter.stopComposition()
+        learningPersistence.replayIfNeeded()
+
+        warmUpOptions = nil
+        zenzaiLoaded = serverConfig.isZenzaiEnabled
+        warmUpTimeMs = Int64(Date().timeIntervalSince(startTime) * 1000)
+        warmUpState = .ready
+        NSLog("Warm-up finished in \(warmUpTimeMs) ms")
+    }
+
+    func getServerStatus() -> Hazkey_ResponseEnvelope {
+        var status = Hazkey_Commands_ServerStatus()
+        if converterLock.wait(timeout: .now()) == .success {
+            status.warmUpState = warmUpState
+            status.warmUpTimeMs = warmUpTimeMs
+            status.zenzaiLoaded = zenzaiLoaded
+            converterLock.signal()
+        } else {
+            status.warmUpState = .warmingUp
+        }
+        return Hazkey_ResponseEnvelope.with {
+            $0.status = .success
+            $0.serverStatus = status
+        }
+    }
 
-        NSLog("State configuration reinitialized successfully")
+    func getStats() -> Hazkey_ResponseEnvelope {
+        var result = stats.snapshot()
+        result.learningDataBytes =
+            ServerStats.diskUsage(
+                HazkeyServerConfig.getStateDirectory().appendingPathComponent(
+                    "memory", isDirectory: true))
+            + ServerStats.diskUsage(learningPersistence.journalURL)
+        result.zenzaiAvailable = serverConfig.zenzaiAvailable
+        result.configSaveError = HazkeyServerConfig.lastSaveError ?? ""
+        result.inProcess = inProcess
+        if converterLock.wait(timeout: .now()) == .success {
+            result.zenzaiLoaded = zenzaiLoaded
+            converterLock.signal()
+        }
+        return Hazkey_ResponseEnvelope.with {
+            $0.status = .success
+            $0.stats = result
+        }
     }
 
 }
+
+// The converter is shared with the warm-up queue; every access to it is
+// serialized by `converterLock`.
+extension HazkeyServerState: @unchecked Sendable {}
@@ -7,14 +7,11 @@ extension ComposingText {
     }
 
     func toKatakana(_ fullwidth: Bool) -> String {
-        let hiragana = self.toHiragana()
-        let katakanaFullwidth =
-            hiragana.applyingTransform(.hiraganaToKatakana, reverse: false) ?? hiragana
+        let katakanaFullwidth = KanaTable.hiraganaToKatakana(self.toHiragana())
         if fullwidth {
             return katakanaFullwidth
         } else {
-            return katakanaFullwidth.applyingTransform(.fullwidthToHalfwidth, reverse: false)
-                ?? katakanaFullwidth
+            return KanaTable.fullwidthToHalfwidth(katakanaFullwidth)
         }
     }
 
@@ -29,22 +26,41 @@ extension ComposingText {
                 return nil
             }
         }
-        return String(romaji).applyingTransform(.fullwidthToHalfwidth, reverse: fullwidth) ?? ""
+        return fullwidth
+            ? KanaTable.halfwidthToFullwidth(String(romaji))
+            : KanaTable.fullwidthToHalfwidth(String(romaji))
     }
 }
 
-func cycleAlphabetCase(_ alphabet: String, preedit: String) -> String {
-    if preedit == alphabet.lowercased() {
-        return alphabet.uppercased()
-    } else if preedit == alphabet.uppercased() && alphabet.count > 1 {
-        return alphabet.capitalized
-    } else if alphabet != alphabet.uppercased()
+/// The cases F9/F10 step through for `alphabet`, in order: the romaji as
+/// typed when it is mixed case, then lower case, upper case and, for more
+/// than one character, capitalized. Forms that come out the same are listed
+/// once. Clients get this list in ComposingVariants.
+func alphabetCaseCycle(_ alphabet: String) -> [String] {
+    var forms: [String] = []
+    if alphabet != alphabet.uppercased()
         && alphabet != alphabet.lowercased()
         && alphabet != alphabet.capitalized
-        && alphabet != preedit
     {
-        return alphabet
-    } else {
-        return alphabet.lowercased()
+        forms.append(alphabet)
+    }
+    forms.append(alphabet.lowercased())
+    forms.append(alphabet.uppercased())
+    if alphabet.count > 1 {
+        forms.append(alphabet.capitalized)
+    }
+    var cycle: [String] = []
+    for form in forms where !cycle.contains(form) {
+        cycle.append(form)
+    }
+    return cycle
+}
+
+/// The case after `preedit` in alphabetCaseCycle(), or the first one.
+func cycleAlphabetCase(_ alphabet: String, preedit: String) -> String {
+    let cycle = alphabetCaseCycle(alphabet)
+    guard let index = cycle.firstIndex(of: preedit) else {
+        return cycle[0]
     }
+    return cycle[(index + 1) % cycle.count]
 }
@@ -0,0 +1,142 @@
+import Foundation
+
+/// Chrome/Perfetto trace-event output, enabled by HAZKEY_TRACE_FILE.
+///
+/// fcitx5-hazkey appends to the same file in the same format (see
+/// hazkey_trace.h), and both use CLOCK_MONOTONIC, so one trace shows the
+/// client key event, the request and the server work on a single timeline.
+/// Spans carry the trace ID sent in the request envelope.
+///
+/// The variable is read from the environment of each process. hazkey-server
+/// started by fcitx5-hazkey inherits it, but one started by hazkey-settings
+/// only has it if hazkey-settings was started with it, so restart the server
+/// from fcitx5 (or set the variable for both) when tracing. In in-process
+/// mode the core writes with the addon's pid and thread IDs, so its spans
+/// nest under the addon's request spans.
+final class TraceWriter {
+    static let shared = TraceWriter(
+        path: ProcessInfo.processInfo.environment["HAZKEY_TRACE_FILE"])
+
+    private let fd: Int32
+    private let pid = getpid()
+    private let lock = NSLock()
+
+    // trace ID of the request being processed
+    var currentTraceId: UInt64 = 0
+
+    var enabled: Bool { fd >= 0 }
+
+    init(path: String?) {
+        guard let path, !path.isEmpty else {
+            fd = -1
+            return
+        }
+        fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0o600)
+        guard fd >= 0 else {
+            NSLog("Failed to open trace file: \(path)")
+            return
+        }
+        var st = stat()
+        if fstat(fd, &st) == 0 && st.st_size == 0 {
+            writeLine("[")
+        }
+    }
+
+    /// Names the track of this process. Only the server calls this; in
+    /// in-process mode the process is fcitx5-hazkey's.
+    func nameProcess(_ name: String) {
+        guard enabled else {
+            return
+        }
+        writeLine(
+            "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":\(pid),"
+                + "\"args\":{\"name\":\(Self.jsonString(name))}},")
+    }
+
+    deinit {
+        if fd >= 0 {
+            close(fd)
+        }
+    }
+
+    /// Microseconds on CLOCK_MONOTONIC, like std::chrono::steady_clock.
+    static func now() -> UInt64 {
+        var ts = timespec()
+        clock_gettime(CLOCK_MONOTONIC, &ts)
+        return UInt64(ts.tv_sec) * 1_000_000 + UInt64(ts.tv_nsec) / 1000
+    }
+
+    func span<T>(_ name: String, category: String, detail: String = "", _ body: () -> T) -> T {
+        guard enabled else {
+            return body()
+        }
+        let start = Self.now()
+        let result = body()
+        writeSpan(name, category: category, start: start, end: Self.now(), detail: detail)
+        return result
+    }
+
+    func writeSpan(
+        _ name: String, category: String, start: UInt64, end: UInt64, detail: String = ""
+    ) {
+        guard enabled else {
+            return
+        }
+        var args = "\"trace_id\":\"\(currentTraceId)\""
+        if !detail.isEmpty {
+            args += ",\"detail\":\(Self.jsonString(detail))"
+        }
+        writeLine(
+            "{\"name\":\(Self.jsonString(name)),\"cat\":\(Self.jsonString(category)),"
+                + "\"ph\":\"X\",\"ts\":\(start),\"dur\":\(end - start),"
+                + "\"pid\":\(pid),\"tid\":\(Self.threadId() ?? pid),\"args\":{\(args)}},")
+    }
+
+    // Kernel thread ID, like gettid(), which Swift does not import.
+    // /proc/thread-self links to "<pid>/task/<tid>".
+    private static func threadId() -> Int32? {
+        var buffer = [CChar](repeating: 0, count: 64)
+        let length = readlink("/proc/thread-self", &buffer, buffer.count - 1)
+        guard length > 0 else {
+            return nil
+        }
+        let target = String(cString: buffer)
+        guard let slash = target.lastIndex(of: "/") else {
+            return nil
+        }
+        return Int32(target[target.index(after: slash)...])
+    }
+
+    // one write() per event, so that appends from both processes do not interleave
+    private func writeLine(_ line: String) {
+        let data = Array((line + "\n").utf8)
+        lock.lock()
+        defer { lock.unlock() }
+        _ = data.withUnsafeBytes { write(fd, $0.baseAddress, $0.count) }
+    }
+
+    private static func jsonString(_ text: String) -> String {
+        var escaped = "\""
+        for scalar in text.unicodeScalars {
+            switch scalar {
+            case "\"":
+                escaped += "\\\""
+            case "\\":
+                escaped += "\\\\"
+            case "\n":
+                escaped += "\\n"
+            default:
+                if scalar.value < 0x20 {
+                    escaped += String(format: "\\u%04x", scalar.value)
+                } else {
+                    escaped.unicodeScalars.append(scalar)
+                }
+            }
+        }
+        return escaped + "\""
+    }
+}
+
+// The file descriptor is immutable and writes are serialized by `lock`;
+// `currentTraceId` is only touched from the request loop.
+extension TraceWriter: @unchecked Sendable {}
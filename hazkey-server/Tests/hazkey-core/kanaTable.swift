@@ -0,0 +1,112 @@
+import Foundation
+import XCTest
+
+@testable import HazkeyCore
+
+final class KanaTableTests: XCTestCase {
+
+  // Everything a reading or romaji input is made of, plus the blocks the
+  // tables hand over to ICU.
+  private static let scalarRanges: [ClosedRange<UInt32>] = [
+    0x0020...0x007E,
+    0x00A0...0x00FF,
+    0x0300...0x036F,
+    0x1100...0x11FF,
+    0x2190...0x2193,
+    0x3000...0x30FF,
+    0x3131...0x3163,
+    0x3200...0x33FF,
+    0xFF01...0xFFEE,
+  ]
+
+  private static let samples = [
+    "きょうはいいてんきですね",
+    "がっこうへいく、ぱーてぃー。",
+    "ゔぁいおりん「じゅんび」・ちゅうい",
+    "ゝゞゕゖ",
+    "わ\u{3099}",
+    "ｶﾞｷﾞ ﾊﾟ",
+    "Hello, World! 123",
+    "ＡＢＣ１２３　！？",
+    "￥１，０００",
+    "ｶﾞｯｺｳ｡ﾊﾟｰﾃｨｰ",
+    "ゟヿ㋐㌀",
+    "か\u{302B}\u{302A}",
+    "⦅ｶ⦆",
+  ]
+
+  private static var singleCharacters: [String] {
+    return scalarRanges.flatMap { range in
+      range.compactMap { Unicode.Scalar($0).map { String($0) } }
+    }
+  }
+
+  func testHiraganaToKatakanaMatchesICU() {
+    for text in Self.singleCharacters + Self.samples {
+      XCTAssertEqual(
+        KanaTable.hiraganaToKatakana(text),
+        text.applyingTransform(.hiraganaToKatakana, reverse: false) ?? text,
+        "hiraganaToKatakana(\(text))")
+    }
+  }
+
+  func testFullwidthToHalfwidthMatchesICU() {
+    let katakana = Self.samples.map {
+      $0.applyingTransform(.hiraganaToKatakana, reverse: false) ?? $0
+    }
+    for text in Self.singleCharacters + Self.samples + katakana {
+      XCTAssertEqual(
+        KanaTable.fullwidthToHalfwidth(text),
+        text.applyingTransform(.fullwidthToHalfwidth, reverse: false) ?? text,
+        "fullwidthToHalfwidth(\(text))")
+    }
+  }
+
+  func testHalfwidthToFullwidthMatchesICU() {
+    for text in Self.singleCharacters + Self.samples {
+      XCTAssertEqual(
+        KanaTable.halfwidthToFullwidth(text),
+        text.applyingTransform(.fullwidthToHalfwidth, reverse: true) ?? text,
+        "halfwidthToFullwidth(\(text))")
+    }
+  }
+
+  func testVoicedKatakanaDecomposes() {
+    XCTAssertEqual(KanaTable.fullwidthToHalfwidth("ガパヴヺ"), "ｶﾞﾊﾟｳﾞｦﾞ")
+  }
+
+  // Cases where ICU does not do what a plain table would.
+  func testICUSpecialCases() {
+    XCTAssertEqual(KanaTable.hiraganaToKatakana("ゕゖ"), "ゕゖ")
+    XCTAssertEqual(KanaTable.hiraganaToKatakana("ｶﾞ"), "ガ")
+    XCTAssertEqual(KanaTable.hiraganaToKatakana("ヿ"), "コト")
+    XCTAssertEqual(KanaTable.fullwidthToHalfwidth("⦅⦆"), "⦅⦆")
+    XCTAssertEqual(KanaTable.fullwidthToHalfwidth("\u{1100}"), "\u{FFA1}")
+    XCTAssertEqual(KanaTable.fullwidthToHalfwidth("ヷ゛"), "ﾜﾞ゛")
+  }
+
+  // Microbenchmarks: a typical reading through the F7/F8 path, the table
+  // against ICU.
+
+  private static let benchmarkReading = String(repeating: "がっこうでぱーてぃーをする", count: 4)
+
+  func testPerformanceHalfwidthKatakanaTable() {
+    measure {
+      for _ in 0..<1000 {
+        _ = KanaTable.fullwidthToHalfwidth(
+          KanaTable.hiraganaToKatakana(Self.benchmarkReading))
+      }
+    }
+  }
+
+  func testPerformanceHalfwidthKatakanaICU() {
+    measure {
+      for _ in 0..<1000 {
+        let katakana =
+          Self.benchmarkReading.applyingTransform(.hiraganaToKatakana, reverse: false)
+          ?? Self.benchmarkReading
+        _ = katakana.applyingTransform(.fullwidthToHalfwidth, reverse: false)
+      }
+    }
+  }
+}
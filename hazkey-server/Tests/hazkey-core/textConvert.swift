@@ -0,0 +1,36 @@
+import Foundation
+import XCTest
+
+@testable import HazkeyCore
+
+final class AlphabetCaseTests: XCTestCase {
+
+  func testLowerCaseCycle() {
+    XCTAssertEqual(alphabetCaseCycle("kanji"), ["kanji", "KANJI", "Kanji"])
+  }
+
+  func testMixedCaseStartsAsTyped() {
+    XCTAssertEqual(alphabetCaseCycle("kAnji"), ["kAnji", "kanji", "KANJI", "Kanji"])
+  }
+
+  func testSingleCharacterHasNoCapitalized() {
+    XCTAssertEqual(alphabetCaseCycle("k"), ["k", "K"])
+  }
+
+  func testSameFormsAreListedOnce() {
+    XCTAssertEqual(alphabetCaseCycle("123"), ["123"])
+  }
+
+  // The old rules went from upper case back to itself when it equals the
+  // capitalized form; the cycle moves on to lower case.
+  func testCycleWrapsAround() {
+    XCTAssertEqual(cycleAlphabetCase("a1", preedit: "a1"), "A1")
+    XCTAssertEqual(cycleAlphabetCase("a1", preedit: "A1"), "a1")
+    XCTAssertEqual(cycleAlphabetCase("kanji", preedit: "Kanji"), "kanji")
+  }
+
+  func testPreeditOutsideTheCycleStartsIt() {
+    XCTAssertEqual(cycleAlphabetCase("kAnji", preedit: "かんじ"), "kAnji")
+    XCTAssertEqual(cycleAlphabetCase("kanji", preedit: "かんじ"), "kanji")
+  }
+}
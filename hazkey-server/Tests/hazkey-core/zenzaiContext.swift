@@ -0,0 +1,81 @@
+import XCTest
+
+@testable import HazkeyCore
+
+final class ZenzaiContextTests: XCTestCase {
+
+  private func context(_ text: String, previous: String = "", limit: Int = 40) -> String {
+    return HazkeyServerConfig.anchoredZenzaiLeftContext(text, previous: previous, limit: limit)
+  }
+
+  // Types `count` characters after `text` one by one, sending the last
+  // `window` characters each time as the client does, and returns every
+  // context picked.
+  private func typeAlong(_ text: String, count: Int, window: Int) -> [String] {
+    var typed = text
+    var previous = ""
+    var contexts: [String] = []
+    let characters = Array("かきくけこさしすせそたちつてと")
+    for i in 0..<count {
+      typed.append(characters[i % characters.count])
+      previous = context(String(typed.suffix(window)), previous: previous, limit: window)
+      contexts.append(previous)
+    }
+    return contexts
+  }
+
+  func testShortContextIsKept() {
+    XCTAssertEqual(context("今日は晴れ。"), "今日は晴れ。")
+  }
+
+  // Without punctuation the start stays put until the context reaches the
+  // limit, and then moves once to leave half of it.
+  func testPrefixIsStableWithoutPunctuation() {
+    let contexts = typeAlong(String(repeating: "あ", count: 60), count: 100, window: 40)
+    var moves = 0
+    for (previous, current) in zip(contexts, contexts.dropFirst()) {
+      XCTAssertLessThanOrEqual(current.count, 40)
+      if !current.hasPrefix(previous) {
+        moves += 1
+        XCTAssertEqual(current.count, 20)
+      }
+    }
+    // 100 characters at 20 per move
+    XCTAssertLessThanOrEqual(moves, 5)
+  }
+
+  func testContextGrowsFromAnchor() {
+    let first = context("あいうえお", previous: "いう", limit: 40)
+    XCTAssertEqual(first, "いうえお")
+  }
+
+  func testLimitComesFromWindow() {
+    let previous = String(repeating: "あ", count: 100)
+    let text = previous + String(repeating: "い", count: 50)
+    XCTAssertEqual(context(text, previous: previous, limit: 200), text)
+    XCTAssertEqual(context(text, previous: previous, limit: 120).count, 60)
+  }
+
+  func testFirstContextKeepsHalfTheLimit() {
+    let text = String(repeating: "あ", count: 50)
+    XCTAssertEqual(context(text), String(repeating: "あ", count: 20))
+  }
+
+  func testMoveStartsAfterBoundary() {
+    let sentence = String(repeating: "い", count: 15)
+    let text = String(repeating: "あ", count: 40) + "。" + sentence
+    XCTAssertEqual(context(text), sentence)
+  }
+
+  func testBoundaryNearEndIsIgnored() {
+    let text = String(repeating: "あ", count: 45) + "。あ"
+    XCTAssertEqual(context(text), String(text.suffix(20)))
+  }
+
+  // After an edit the old context is gone and a new start is picked.
+  func testEditedTextMovesStart() {
+    let text = String(repeating: "い", count: 30)
+    XCTAssertEqual(
+      context(text, previous: "あいう"), String(repeating: "い", count: 20))
+  }
+}
@@ -1,10 +1,12 @@
 import Foundation
 import XCTest
 
-@testable import hazkey-server
+@testable import HazkeyCore
 
 class BaseHazkeyServerTestCase: XCTestCase {
   var client: HazkeyServerClient!
+  // The user's profiles, put back after each test
+  private var savedProfiles: [Hazkey_Config_Profile] = []
 
   override func setUpWithError() throws {
     try super.setUpWithError()
@@ -24,12 +26,23 @@ class BaseHazkeyServerTestCase: XCTestCase {
   }
 
   override func tearDownWithError() throws {
+    if let client = client, !savedProfiles.isEmpty {
+      let restoreResponse = try client.sendQuery(
+        QueryDataBuilder.setConfig(fileHashes: [], profiles: savedProfiles))
+      XCTAssertEqual(restoreResponse.status, .success, "Failed to restore configuration")
+    }
     client?.disconnect()
     client = nil
     try super.tearDownWithError()
   }
 
   private func initializeServerState() throws {
+    let getConfigResponse = try client.sendQuery(QueryDataBuilder.getConfig())
+    XCTAssertEqual(getConfigResponse.status, .success, "Failed to get configuration")
+    if case .currentConfig(let config) = getConfigResponse.payload {
+      savedProfiles = config.profiles
+    }
+
     // Set default configuration
     let configQuery = QueryDataBuilder.setConfig()
     let configResponse = try client.sendQuery(configQuery)
@@ -43,10 +56,10 @@ class BaseHazkeyServerTestCase: XCTestCase {
 
   // Helper method for sending queries with better error reporting
   func sendQuery(
-    _ query: Hazkey_Commands_QueryData,
+    _ query: Hazkey_RequestEnvelope,
     file: StaticString = #file,
     line: UInt = #line
-  ) throws -> Hazkey_Commands_ResultData {
+  ) throws -> Hazkey_ResponseEnvelope {
     do {
       return try client.sendQuery(query)
     } catch {
@@ -1,7 +1,7 @@
 import Foundation
 import XCTest
 
-@testable import hazkeyServer
+@testable import HazkeyCore
 
 final class CandidateTests: BaseHazkeyServerTestCase {
 
@@ -13,7 +13,7 @@ final class CandidateTests: BaseHazkeyServerTestCase {
       candidatesResponse.status, .success, "Getting candidates should succeed even with empty input"
     )
 
-    if case .candidates(let candidatesResult) = candidatesResponse.props {
+    if case .candidates(let candidatesResult) = candidatesResponse.payload {
       XCTAssertTrue(
         candidatesResult.candidates.isEmpty || candidatesResult.candidates.count > 0,
         "Should return candidates array (empty or populated)")
@@ -28,12 +28,12 @@ final class CandidateTests: BaseHazkeyServerTestCase {
     let inputResponse = try sendQuery(inputQuery)
     XCTAssertEqual(inputResponse.status, .success)
 
-    let candidatesQuery = QueryDataBuilder.getCandidates(nBest: 5)
+    let candidatesQuery = QueryDataBuilder.getCandidates()
     let candidatesResponse = try sendQuery(candidatesQuery)
 
     XCTAssertEqual(candidatesResponse.status, .success, "Getting candidates should succeed")
 
-    if case .candidates(let candidatesResult) = candidatesResponse.props {
+    if case .candidates(let candidatesResult) = candidatesResponse.payload {
       XCTAssertFalse(
         candidatesResult.candidates.isEmpty, "Should return some candidates for hiragana input")
 
@@ -46,19 +46,18 @@ final class CandidateTests: BaseHazkeyServerTestCase {
     }
   }
 
-  func testGetCandidatesWithNBestLimit() throws {
+  func testGetCandidatesReportsPageSize() throws {
     let inputQuery = QueryDataBuilder.inputText("あ")
     let inputResponse = try sendQuery(inputQuery)
     XCTAssertEqual(inputResponse.status, .success)
 
-    let nBest: Int32 = 3
-    let candidatesQuery = QueryDataBuilder.getCandidates(nBest: nBest)
+    let candidatesQuery = QueryDataBuilder.getCandidates()
     let candidatesResponse = try sendQuery(candidatesQuery)
 
     XCTAssertEqual(candidatesResponse.status, .success)
 
-    if case .candidates(let candidatesResult) = candidatesResponse.props {
-      XCTAssertTrue(candidatesResult.candidates.count >= 0, "Should return candidates array")
+    if case .candidates(let candidatesResult) = candidatesResponse.payload {
+      XCTAssertGreaterThan(candidatesResult.pageSize, 0, "Should report a page size")
     } else {
       XCTFail("Response should contain candidates")
     }
@@ -69,12 +68,12 @@ final class CandidateTests: BaseHazkeyServerTestCase {
     let inputResponse = try sendQuery(inputQuery)
     XCTAssertEqual(inputResponse.status, .success)
 
-    let candidatesQuery = QueryDataBuilder.getCandidates(isPredictMode: true)
+    let candidatesQuery = QueryDataBuilder.getCandidates(isSuggest: true)
     let candidatesResponse = try sendQuery(candidatesQuery)
 
     XCTAssertEqual(candidatesResponse.status, .success, "Predict mode should work")
 
-    if case .candidates(let candidatesResult) = candidatesResponse.props {
+    if case .candidates(let candidatesResult) = candidatesResponse.payload {
       // In predict mode, we might get prediction candidates
       XCTAssertTrue(candidatesResult.candidates.count >= 0, "Should return candidates array")
     } else {
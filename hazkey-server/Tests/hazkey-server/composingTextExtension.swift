@@ -1,7 +1,7 @@
 import Foundation
 import XCTest
 
-@testable import hazkeyServer
+@testable import HazkeyCore
 
 final class TextInputTests: BaseHazkeyServerTestCase {
 
@@ -13,7 +13,7 @@ final class TextInputTests: BaseHazkeyServerTestCase {
     let getStringQuery = QueryDataBuilder.getComposingString(charType: .hiragana)
     let stringResponse = try sendQuery(getStringQuery)
     XCTAssertEqual(stringResponse.status, .success)
-    XCTAssertEqual(stringResponse.result, "あ", "Should return the input hiragana character")
+    XCTAssertEqual(stringResponse.text, "あ", "Should return the input hiragana character")
   }
 
   func testMultipleCharacterInput() throws {
@@ -28,7 +28,7 @@ final class TextInputTests: BaseHazkeyServerTestCase {
     let getStringQuery = QueryDataBuilder.getComposingString(charType: .hiragana)
     let stringResponse = try sendQuery(getStringQuery)
     XCTAssertEqual(stringResponse.status, .success)
-    XCTAssertEqual(stringResponse.result, "あいう", "Should concatenate multiple hiragana characters")
+    XCTAssertEqual(stringResponse.text, "あいう", "Should concatenate multiple hiragana characters")
   }
 
   func testDirectInput() throws {
@@ -40,7 +40,7 @@ final class TextInputTests: BaseHazkeyServerTestCase {
     let stringResponse = try sendQuery(getStringQuery)
     XCTAssertEqual(stringResponse.status, .success)
     XCTAssertEqual(
-      stringResponse.result, "A", "Direct input should preserve the original character")
+      stringResponse.text, "A", "Direct input should preserve the original character")
   }
 
   func testEmptyStringInput() throws {
@@ -54,7 +54,7 @@ final class TextInputTests: BaseHazkeyServerTestCase {
 
   func testNumericInputWithFullwidthConfiguration() throws {
     // Set configuration for fullwidth numbers
-    let configQuery = QueryDataBuilder.setConfig(numberFullwidth: 1)
+    let configQuery = QueryDataBuilder.setConfig(numberFullwidth: true)
     let configResponse = try sendQuery(configQuery)
     XCTAssertEqual(configResponse.status, .success)
 
@@ -70,7 +70,18 @@ final class TextInputTests: BaseHazkeyServerTestCase {
     let getStringQuery = QueryDataBuilder.getComposingString(charType: .hiragana)
     let stringResponse = try sendQuery(getStringQuery)
     XCTAssertEqual(stringResponse.status, .success)
-    XCTAssertEqual(stringResponse.result, "１", "Only first character should be processed")
+    XCTAssertEqual(stringResponse.text, "１", "Only first character should be processed")
+  }
+
+  func testNumericInputWithHalfwidthConfiguration() throws {
+    let inputQuery = QueryDataBuilder.inputText("123")
+    let inputResponse = try sendQuery(inputQuery)
+    XCTAssertEqual(inputResponse.status, .success)
+
+    let getStringQuery = QueryDataBuilder.getComposingString(charType: .hiragana)
+    let stringResponse = try sendQuery(getStringQuery)
+    XCTAssertEqual(stringResponse.status, .success)
+    XCTAssertEqual(stringResponse.text, "1", "Numbers should stay halfwidth by default")
   }
 
   func testCharacterTypeConversion() throws {
@@ -79,7 +90,7 @@ final class TextInputTests: BaseHazkeyServerTestCase {
     XCTAssertEqual(inputResponse.status, .success)
 
     // Test different character type outputs
-    let testCases: [(Hazkey_Commands_QueryData.GetComposingStringProps.CharType, String)] = [
+    let testCases: [(Hazkey_Commands_GetComposingString.CharType, String)] = [
       (.hiragana, "あ"),
       (.katakanaFull, "ア"),
       (.katakanaHalf, "ｱ"),
@@ -90,7 +101,7 @@ final class TextInputTests: BaseHazkeyServerTestCase {
       let stringResponse = try sendQuery(getStringQuery)
       XCTAssertEqual(stringResponse.status, .success)
       XCTAssertEqual(
-        stringResponse.result, expected,
+        stringResponse.text, expected,
         "Character type \(charType) should return \(expected)")
     }
   }
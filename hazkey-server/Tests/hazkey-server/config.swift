@@ -1,22 +1,31 @@
 import Foundation
 import XCTest
 
-@testable import hazkeyServer
+@testable import HazkeyCore
 
 final class ConfigurationTests: BaseHazkeyServerTestCase {
+  func testGetConfiguration() throws {
+    let response = try sendQuery(QueryDataBuilder.getConfig())
+
+    XCTAssertEqual(response.status, .success, "Getting configuration should succeed")
+    if case .currentConfig(let config) = response.payload {
+      XCTAssertFalse(config.profiles.isEmpty, "Configuration should have a profile")
+    } else {
+      XCTFail("Response should contain the current configuration")
+    }
+  }
+
   func testSetCustomConfiguration() throws {
-    let query = QueryDataBuilder.setConfig(
-      commaStyle: 1,
-      numberFullwidth: 1,
-      periodStyle: 2,
-      spaceFullwidth: 1,
-      symbolFullwidth: 1,
-      tenCombining: 1,
+    let profile = QueryDataBuilder.testProfile(
+      numberFullwidth: true,
+      spaceFullwidth: true,
+      symbolFullwidth: true,
       zenzaiEnabled: true,
       zenzaiInferLimit: 5
     )
 
-    let response = try sendQuery(query)
+    let response = try sendQuery(
+      QueryDataBuilder.setConfig(fileHashes: [], profiles: [profile]))
 
     XCTAssertEqual(
       response.status, .success,
@@ -24,13 +33,22 @@ final class ConfigurationTests: BaseHazkeyServerTestCase {
     XCTAssertTrue(
       response.errorMessage.isEmpty,
       "Error message should be empty on success")
+
+    // Read back right away; GetConfig must see what SetConfig applied
+    let readBack = try sendQuery(QueryDataBuilder.getConfig())
+    XCTAssertEqual(readBack.status, .success)
+    if case .currentConfig(let config) = readBack.payload {
+      XCTAssertEqual(config.profiles, [profile], "Profiles should be kept")
+    } else {
+      XCTFail("Response should contain the current configuration")
+    }
   }
 
   func testConfigurationPersistence() throws {
     // Set a custom configuration
     let customConfig = QueryDataBuilder.setConfig(
-      numberFullwidth: 1,
-      symbolFullwidth: 1
+      numberFullwidth: true,
+      symbolFullwidth: true
     )
     let configResponse = try sendQuery(customConfig)
     XCTAssertEqual(configResponse.status, .success)
@@ -51,7 +69,7 @@ final class ConfigurationTests: BaseHazkeyServerTestCase {
 
     // With fullwidth numbers enabled, "1" should become "１"
     XCTAssertEqual(
-      stringResponse.result, "１",
+      stringResponse.text, "１",
       "Number should be converted to fullwidth when numberFullwidth is enabled")
   }
 }
@@ -1,25 +1,17 @@
 import Foundation
 import XCTest
 
-@testable import hazkeyServer
+@testable import HazkeyCore
 
 final class IntegrationTests: BaseHazkeyServerTestCase {
 
   func testCompleteInputWorkflow() throws {
-    // 1. Set custom configuration
-    let configQuery = QueryDataBuilder.setConfig(
-      numberFullwidth: 1,
-      symbolFullwidth: 1
-    )
-    let configResponse = try sendQuery(configQuery)
-    XCTAssertEqual(configResponse.status, .success)
-
-    // 2. Create composing text instance
+    // 1. Create composing text instance
     let instanceQuery = QueryDataBuilder.createComposingTextInstance()
     let instanceResponse = try sendQuery(instanceQuery)
     XCTAssertEqual(instanceResponse.status, .success)
 
-    // 3. Input multiple characters
+    // 2. Input multiple characters
     let inputChars = ["こ", "ん", "に", "ち", "は"]
     for char in inputChars {
       let inputQuery = QueryDataBuilder.inputText(char)
@@ -27,18 +19,18 @@ final class IntegrationTests: BaseHazkeyServerTestCase {
       XCTAssertEqual(inputResponse.status, .success, "Input of '\(char)' should succeed")
     }
 
-    // 4. Get composing string
+    // 3. Get composing string
     let getStringQuery = QueryDataBuilder.getComposingString(charType: .hiragana)
     let stringResponse = try sendQuery(getStringQuery)
     XCTAssertEqual(stringResponse.status, .success)
-    XCTAssertEqual(stringResponse.result, "こんにちは", "Should compose complete hiragana string")
+    XCTAssertEqual(stringResponse.text, "こんにちは", "Should compose complete hiragana string")
 
-    // 5. Get candidates
+    // 4. Get candidates
     let candidatesQuery = QueryDataBuilder.getCandidates()
     let candidatesResponse = try sendQuery(candidatesQuery)
     XCTAssertEqual(candidatesResponse.status, .success)
 
-    if case .candidates(let candidatesResult) = candidatesResponse.props {
+    if case .candidates(let candidatesResult) = candidatesResponse.payload {
       XCTAssertFalse(candidatesResult.candidates.isEmpty, "Should return candidates for 'こんにちは'")
 
       // Check if we get "こんにちは" or "今日は" as candidates
@@ -54,8 +46,8 @@ final class IntegrationTests: BaseHazkeyServerTestCase {
   func testNumberAndSymbolConversion() throws {
     // Configure for fullwidth conversion
     let configQuery = QueryDataBuilder.setConfig(
-      numberFullwidth: 1,
-      symbolFullwidth: 1
+      numberFullwidth: true,
+      symbolFullwidth: true
     )
     let configResponse = try sendQuery(configQuery)
     XCTAssertEqual(configResponse.status, .success)
@@ -72,7 +64,7 @@ final class IntegrationTests: BaseHazkeyServerTestCase {
     let getNumberQuery = QueryDataBuilder.getComposingString()
     let numberStringResponse = try sendQuery(getNumberQuery)
     XCTAssertEqual(numberStringResponse.status, .success)
-    XCTAssertEqual(numberStringResponse.result, "５", "Number should be converted to fullwidth")
+    XCTAssertEqual(numberStringResponse.text, "５", "Number should be converted to fullwidth")
   }
 
   func testMultipleSessionsSequentially() throws {
@@ -94,6 +86,6 @@ final class IntegrationTests: BaseHazkeyServerTestCase {
     let session2GetQuery = QueryDataBuilder.getComposingString()
     let session2StringResponse = try sendQuery(session2GetQuery)
     XCTAssertEqual(session2StringResponse.status, .success)
-    XCTAssertEqual(session2StringResponse.result, "", "New session should start with empty state")
+    XCTAssertEqual(session2StringResponse.text, "", "New session should start with empty state")
   }
 }
@@ -2,7 +2,7 @@ import Foundation
 import SwiftGlibc
 import XCTest
 
-@testable import hazkeyServer
+@testable import HazkeyCore
 
 // MARK: - Test Configuration
 struct TestConfig {
@@ -13,70 +13,101 @@ struct TestConfig {
 
 // MARK: - Test Data Builders
 struct QueryDataBuilder {
+  static func getConfig() -> Hazkey_RequestEnvelope {
+    return Hazkey_RequestEnvelope.with {
+      $0.getConfig = Hazkey_Config_GetConfig()
+    }
+  }
+
   static func setConfig(
-    commaStyle: Int32 = 0,
-    numberFullwidth: Int32 = 0,
-    periodStyle: Int32 = 0,
-    spaceFullwidth: Int32 = 0,
-    symbolFullwidth: Int32 = 0,
-    tenCombining: Int32 = 0,
+    fileHashes: [Hazkey_Config_FileHash],
+    profiles: [Hazkey_Config_Profile]
+  ) -> Hazkey_RequestEnvelope {
+    return Hazkey_RequestEnvelope.with {
+      $0.setConfig = Hazkey_Config_SetConfig.with {
+        $0.fileHashes = fileHashes
+        $0.profiles = profiles
+      }
+    }
+  }
+
+  // The width options are the built-in keymaps of the same name now.
+  static func setConfig(
+    numberFullwidth: Bool = false,
+    spaceFullwidth: Bool = false,
+    symbolFullwidth: Bool = false,
     zenzaiEnabled: Bool = false,
     zenzaiInferLimit: Int32 = 1
-  ) -> Hazkey_Commands_QueryData {
-    var query = Hazkey_Commands_QueryData()
-    query.function = .setConfig
-    query.setConfig = Hazkey_Commands_QueryData.SetConfigProps.with {
-      $0.commaStyle = commaStyle
-      $0.numberFullwidth = numberFullwidth
-      $0.periodStyle = periodStyle
-      $0.profileText = ""
-      $0.spaceFullwidth = spaceFullwidth
-      $0.symbolFullwidth = symbolFullwidth
-      $0.tenCombining = tenCombining
-      $0.zenzaiEnabled = zenzaiEnabled
-      $0.zenzaiInferLimit = zenzaiInferLimit
+  ) -> Hazkey_RequestEnvelope {
+    return setConfig(
+      fileHashes: [],
+      profiles: [
+        testProfile(
+          numberFullwidth: numberFullwidth,
+          spaceFullwidth: spaceFullwidth,
+          symbolFullwidth: symbolFullwidth,
+          zenzaiEnabled: zenzaiEnabled,
+          zenzaiInferLimit: zenzaiInferLimit)
+      ])
+  }
+
+  static func testProfile(
+    numberFullwidth: Bool = false,
+    spaceFullwidth: Bool = false,
+    symbolFullwidth: Bool = false,
+    zenzaiEnabled: Bool = false,
+    zenzaiInferLimit: Int32 = 1
+  ) -> Hazkey_Config_Profile {
+    var profile = HazkeyServerConfig.genDefaultConfig()
+    let keymaps: [(name: String, enabled: Bool)] = [
+      ("Fullwidth Number", numberFullwidth),
+      ("Fullwidth Symbol", symbolFullwidth),
+      ("Japanese Symbol", true),
+      ("Fullwidth Space", spaceFullwidth),
+    ]
+    profile.enabledKeymaps = keymaps.filter { $0.enabled }.map { keymap in
+      Hazkey_Config_Profile.EnabledKeymap.with {
+        $0.name = keymap.name
+        $0.isBuiltIn = true
+        $0.filename = keymap.name
+      }
     }
-    return query
+    profile.zenzaiEnable = zenzaiEnabled
+    profile.zenzaiInferLimit = zenzaiInferLimit
+    return profile
   }
 
-  static func inputText(_ text: String, isDirect: Bool = false) -> Hazkey_Commands_QueryData {
-    var query = Hazkey_Commands_QueryData()
-    query.function = .inputText
-    query.inputText = Hazkey_Commands_QueryData.InputTextProps.with {
-      $0.text = text
-      $0.isDirect = isDirect
+  static func inputText(_ text: String, isDirect: Bool = false) -> Hazkey_RequestEnvelope {
+    return Hazkey_RequestEnvelope.with {
+      $0.inputChar = Hazkey_Commands_InputChar.with {
+        $0.text = text
+        $0.direct = isDirect
+      }
     }
-    return query
   }
 
   static func getComposingString(
-    charType: Hazkey_Commands_QueryData.GetComposingStringProps.CharType = .hiragana
-  ) -> Hazkey_Commands_QueryData {
-    var query = Hazkey_Commands_QueryData()
-    query.function = .getComposingString
-    query.getComposingString = Hazkey_Commands_QueryData.GetComposingStringProps.with {
-      $0.charType = charType
+    charType: Hazkey_Commands_GetComposingString.CharType = .hiragana
+  ) -> Hazkey_RequestEnvelope {
+    return Hazkey_RequestEnvelope.with {
+      $0.getComposingString = Hazkey_Commands_GetComposingString.with {
+        $0.charType = charType
+      }
     }
-    return query
   }
 
-  static func createComposingTextInstance() -> Hazkey_Commands_QueryData {
-    var query = Hazkey_Commands_QueryData()
-    query.function = .createComposingTextInstance
-    return query
+  static func createComposingTextInstance() -> Hazkey_RequestEnvelope {
+    return Hazkey_RequestEnvelope.with {
+      $0.newComposingText = Hazkey_Commands_NewComposingText()
+    }
   }
 
-  static func getCandidates(
-    nBest: Int32 = 9,
-    isPredictMode: Bool = false
-  ) -> Hazkey_Commands_QueryData {
-    var query = Hazkey_Commands_QueryData()
-    query.function = .getCandidates
-    query.getCandidates = Hazkey_Commands_QueryData.GetCandidatesProps.with {
-      $0.nBest = nBest
-      $0.isPredictMode = isPredictMode
+  static func getCandidates(isSuggest: Bool = false) -> Hazkey_RequestEnvelope {
+    return Hazkey_RequestEnvelope.with {
+      $0.getCandidates = Hazkey_Commands_GetCandidates.with {
+        $0.isSuggest = isSuggest
+      }
     }
-    return query
   }
 }
 
@@ -138,7 +169,7 @@ class HazkeyServerClient {
     }
   }
 
-  func sendQuery(_ query: Hazkey_Commands_QueryData) throws -> Hazkey_Commands_ResultData {
+  func sendQuery(_ query: Hazkey_RequestEnvelope) throws -> Hazkey_ResponseEnvelope {
     guard let socket = socket else {
       throw TestError.notConnected
     }
@@ -146,7 +177,7 @@ class HazkeyServerClient {
     let reqData = try query.serializedData()
     let responseData = try sendRequest(reqData, socket: socket)
 
-    return try Hazkey_Commands_ResultData(serializedBytes: responseData)
+    return try Hazkey_ResponseEnvelope(serializedBytes: responseData)
   }
 
   private func sendRequest(_ reqData: Data, socket: Int32) throws -> Data {
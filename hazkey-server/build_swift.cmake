@@ -25,20 +25,29 @@ if(SWIFT_LINK_PATH)
     list(APPEND SWIFT_COMMAND "-Xlinker" "-L${SWIFT_LINK_PATH}")
 endif()
 
-execute_process(
-    COMMAND ${SWIFT_COMMAND}
-    WORKING_DIRECTORY "${SWIFT_WORK_DIR}"
-    RESULT_VARIABLE result
-)
-
-# The first build fails for an unknown reason.
-if(NOT result EQUAL 0)
+function(swift_build_product PRODUCT)
     execute_process(
-        COMMAND ${SWIFT_COMMAND}
+        COMMAND ${SWIFT_COMMAND} "--product" "${PRODUCT}"
         WORKING_DIRECTORY "${SWIFT_WORK_DIR}"
-        RESULT_VARIABLE result2
+        RESULT_VARIABLE result
     )
-    if(NOT result2 EQUAL 0)
-        message(FATAL_ERROR "Swift build failed after two attempts.")
+
+    # The first build fails for an unknown reason.
+    if(NOT result EQUAL 0)
+        execute_process(
+            COMMAND ${SWIFT_COMMAND} "--product" "${PRODUCT}"
+            WORKING_DIRECTORY "${SWIFT_WORK_DIR}"
+            RESULT_VARIABLE result2
+        )
+        if(NOT result2 EQUAL 0)
+            message(FATAL_ERROR "Swift build of ${PRODUCT} failed after two attempts.")
+        endif()
     endif()
+endfunction()
+
+swift_build_product(hazkey-server)
+
+# libhazkey-core.so for the in-process mode of fcitx5-hazkey
+if(BUILD_CORE_LIBRARY)
+    swift_build_product(hazkey-core)
 endif()
@@ -38,6 +38,7 @@
         <location filename="mainwindow.ui" line="170"/>
         <location filename="mainwindow.ui" line="202"/>
         <location filename="mainwindow.ui" line="234"/>
+        <location filename="mainwindow.ui" line="350"/>
         <source>Disabled</source>
         <translation>無効</translation>
     </message>
@@ -81,6 +82,21 @@
         <source>Number of candidates per page</source>
         <translation>1ページあたりの候補数</translation>
     </message>
+    <message>
+        <location filename="mainwindow.ui" line="340"/>
+        <source>Split long input for conversion above</source>
+        <translation>長い入力を分割して変換する文字数</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="347"/>
+        <source>Readings longer than this are split at punctuation and converted in parts, which keeps long sentences fast. 0 disables it.</source>
+        <translation>読みがこの文字数より長い場合、句読点で区切って部分ごとに変換し、長文の変換を速く保ちます。0 で無効になります。</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="353"/>
+        <source> chars</source>
+        <translation> 文字</translation>
+    </message>
     <message>
         <location filename="mainwindow.ui" line="357"/>
         <source>Convertion</source>
@@ -433,8 +449,58 @@
         <source>Enable Zenzai</source>
         <translation>Zenzaiを有効化</translation>
     </message>
+    <message>
+        <location filename="mainwindow.ui" line="1752"/>
+        <source>Benchmark</source>
+        <translation>ベンチマーク</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1770"/>
+        <source>Measures how long a conversion takes on this computer with the Zenzai settings on the AI tab and some alternatives. A higher inference limit gives better results but takes longer. Typing may lag while each sample is measured.</source>
+        <translation>このコンピューターで、AIタブのZenzai設定といくつかの代替設定を使ったときの変換時間を計測します。推論上限を上げると変換結果は良くなりますが、時間がかかります。計測中は入力が一時的に遅れることがあります。</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1782"/>
+        <source>Latency target (95th percentile)</source>
+        <translation>目標の変換時間（95パーセンタイル）</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1789"/>
+        <source> ms</source>
+        <translation> ms</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1851"/>
+        <source>Use Recommended Setting</source>
+        <translation>推奨設定を使用</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1858"/>
+        <source>Run Benchmark</source>
+        <translation>ベンチマークを実行</translation>
+    </message>
     <message>
         <location filename="mainwindow.ui" line="1720"/>
+        <source>Diagnostics</source>
+        <translation>診断</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1738"/>
+        <source>Timing and resource statistics of the running hazkey server. Please attach them when reporting performance problems.</source>
+        <translation>実行中のhazkey-serverの処理時間とリソースの統計です。動作が遅いなどの問題を報告する際に添付してください。</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1773"/>
+        <source>Refresh</source>
+        <translation>更新</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1780"/>
+        <source>Copy to Clipboard</source>
+        <translation>クリップボードにコピー</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.ui" line="1786"/>
         <source>About</source>
         <translation>情報</translation>
     </message>
@@ -508,13 +574,13 @@
     </message>
     <message>
         <location filename="mainwindow.cpp" line="449"/>
-        <source>Failed to save configuration: %1</source>
-        <translation>設定の保存に失敗しました: %1</translation>
+        <source>Failed to save configuration. Please check your connection to the hazkey server.</source>
+        <translation>設定の保存に失敗しました。hazkeyサーバーへの接続を確認してください。</translation>
     </message>
     <message>
-        <location filename="mainwindow.cpp" line="454"/>
-        <source>An unknown error occurred while saving configuration.</source>
-        <translation>設定の保存中に不明なエラーが発生しました。</translation>
+        <location filename="mainwindow.cpp" line="100"/>
+        <source>The last configuration could not be written to disk: %1</source>
+        <translation>前回の設定をディスクに書き込めませんでした: %1</translation>
     </message>
     <message>
         <location filename="mainwindow.cpp" line="1511"/>
@@ -602,6 +668,71 @@
         <source>Failed to clear input history. Please check your connection to the hazkey server.</source>
         <translation>入力履歴の削除に失敗しました。hazkey-serverとの接続を確認してください。</translation>
     </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1638"/>
+        <source>Failed to get statistics. Please check your connection to the hazkey server.</source>
+        <translation>統計の取得に失敗しました。hazkey-serverとの接続を確認してください。</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1825"/>
+        <source>Setting</source>
+        <translation>設定</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1826"/>
+        <source>p50 (ms)</source>
+        <translation>p50 (ms)</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1827"/>
+        <source>p95 (ms)</source>
+        <translation>p95 (ms)</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1828"/>
+        <source>max (ms)</source>
+        <translation>最大 (ms)</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1838"/>
+        <source>failed</source>
+        <translation>失敗</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1840"/>
+        <source>running...</source>
+        <translation>計測中...</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1844"/>
+        <source>* the current settings on the AI tab</source>
+        <translation>* AIタブの現在の設定</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1850"/>
+        <source>Best setting within %1 ms: %2</source>
+        <translation>%1 ms以内で最適な設定: %2</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1856"/>
+        <source>No setting is within %1 ms.</source>
+        <translation>%1 ms以内に収まる設定はありません。</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1887"/>
+        <source>Zenzai off</source>
+        <translation>Zenzaiなし</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1891"/>
+        <source>Zenzai, limit %1, %2</source>
+        <translation>Zenzai、推論上限 %1、%2</translation>
+    </message>
+    <message>
+        <location filename="mainwindow.cpp" line="1895"/>
+        <source>, contextual</source>
+        <translation>、文脈変換あり</translation>
+    </message>
     <message>
         <location filename="mainwindow.cpp" line="1488"/>
         <source>Japanese Symbol</source>
@@ -673,35 +804,6 @@
         <source>Downloading Zenzai model... %1 MB / %2 MB</source>
         <translation>Zenzaiモデルをダウンロード中... %1 MB / %2 MB</translation>
     </message>
-    <message>
-        <location filename="mainwindow.cpp" line="1637"/>
-        <source>Downloaded file verification failed. Checksum mismatch.
-Expected: %1
-Got: %2</source>
-        <translation>ダウンロードされたファイルの検証に失敗しました。チェックサムが一致しません。
-期待値: %1
-取得地: %2</translation>
-    </message>
-    <message>
-        <location filename="mainwindow.cpp" line="1651"/>
-        <source>Failed to save model file: %1</source>
-        <translation>モデルファイルの保存に失敗しました: %1</translation>
-    </message>
-    <message>
-        <location filename="mainwindow.cpp" line="1658"/>
-        <source>Failed to write model file: %1</source>
-        <translation>モデルファイルの書き込みに失敗しました: %1</translation>
-    </message>
-    <message>
-        <location filename="mainwindow.cpp" line="1670"/>
-        <source>Failed to remove old model file.</source>
-        <translation>古いモデルファイルの削除に失敗しました。</translation>
-    </message>
-    <message>
-        <location filename="mainwindow.cpp" line="1678"/>
-        <source>Failed to rename model file.</source>
-        <translation>モデルファイルの名前変更に失敗しました。</translation>
-    </message>
     <message>
         <location filename="mainwindow.cpp" line="1687"/>
         <source>Download Complete</source>
@@ -724,16 +826,6 @@ UIを更新するには「リセット」を押してください。</translatio
         <source>Resetting will discard any unsaved changes. Continue?</source>
         <translation>リセットすると、保存されていない変更は失われます。続行しますか？</translation>
     </message>
-    <message>
-        <location filename="mainwindow.cpp" line="1727"/>
-        <source>Connection Error</source>
-        <translation>接続エラー</translation>
-    </message>
-    <message>
-        <location filename="mainwindow.cpp" line="1728"/>
-        <source>Failed to connect to server.</source>
-        <translation>サーバーへの接続に失敗しました。</translation>
-    </message>
     <message>
         <location filename="mainwindow.cpp" line="1744"/>
         <source>Failed to load configuration from server.</source>
@@ -770,4 +862,46 @@ UIを更新するには「リセット」を押してください。</translatio
         <translation>Zenzaiモデルのダウンロードに失敗しました: %1</translation>
     </message>
 </context>
+<context>
+    <name>ModelDownloader</name>
+    <message>
+        <location filename="modeldownloader.cpp" line="50"/>
+        <source>Failed to open %1: %2</source>
+        <translation>%1 を開けませんでした: %2</translation>
+    </message>
+    <message>
+        <location filename="modeldownloader.cpp" line="61"/>
+        <source>Download canceled.</source>
+        <translation>ダウンロードがキャンセルされました。</translation>
+    </message>
+    <message>
+        <location filename="modeldownloader.cpp" line="136"/>
+        <source>Failed to write %1: %2</source>
+        <translation>%1 の書き込みに失敗しました: %2</translation>
+    </message>
+    <message>
+        <location filename="modeldownloader.cpp" line="179"/>
+        <source>The server rejected the download range.</source>
+        <translation>サーバーがダウンロード範囲を拒否しました。</translation>
+    </message>
+    <message>
+        <location filename="modeldownloader.cpp" line="197"/>
+        <source>Unexpected HTTP status %1.</source>
+        <translation>予期しない HTTP ステータス %1 です。</translation>
+    </message>
+    <message>
+        <location filename="modeldownloader.cpp" line="222"/>
+        <source>Downloaded file verification failed. Checksum mismatch.
+Expected: %1
+Got: %2</source>
+        <translation>ダウンロードされたファイルの検証に失敗しました。チェックサムが一致しません。
+期待値: %1
+取得値: %2</translation>
+    </message>
+    <message>
+        <location filename="modeldownloader.cpp" line="232"/>
+        <source>Failed to rename model file: %1</source>
+        <translation>モデルファイルの名前変更に失敗しました: %1</translation>
+    </message>
+</context>
 </TS>
@@ -4,41 +4,52 @@
 #include <qnamespace.h>
 
 #include <QAbstractButton>
+#include <QApplication>
 #include <QCheckBox>
+#include <QClipboard>
 #include <QCoreApplication>
 #include <QCryptographicHash>
 #include <QDialogButtonBox>
 #include <QDir>
 #include <QFile>
+#include <QFontDatabase>
+#include <QGuiApplication>
 #include <QHBoxLayout>
 #include <QListWidget>
 #include <QListWidgetItem>
 #include <QMenu>
 #include <QMessageBox>
-#include <QNetworkReply>
-#include <QNetworkRequest>
 #include <QPushButton>
+#include <QSet>
+#include <QSpinBox>
 #include <QStandardPaths>
+#include <QTextStream>
 #include <QThread>
-#include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
 
 #include "./ui_mainwindow.h"
 #include "config_definitions.h"
 #include "config_macros.h"
 #include "constants.h"
 #include "constants.h.in"
+#include "modeldownloader.h"
+#include "percentile.h"
 #include "serverconnector.h"
 
 MainWindow::MainWindow(QWidget* parent)
     : QWidget(parent),
       ui_(new Ui::MainWindow),
-      server_(ServerConnector()),
+      currentProfile_(nullptr),
       isUpdatingFromAdvanced_(false),
       networkManager_(new QNetworkAccessManager(this)),
-      currentDownload_(nullptr),
-      downloadProgressDialog_(nullptr) {
+      modelDownloader_(new ModelDownloader(networkManager_, this)),
+      downloadProgressDialog_(nullptr),
+      busyCount_(0),
+      benchmarkPending_(0) {
     ui_->setupUi(this);
 
     // Expand table settings mode change tab
@@ -52,6 +63,10 @@ MainWindow::MainWindow(QWidget* parent)
             .arg(HAZKEY_VERSION_STR);
     ui_->aboutHazkeyTitleVersionText->setText(hazkeyVersionText);
 
+    // Benchmark results are a table
+    ui_->benchmarkText->setFont(
+        QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
     // Connect UI signals
     connectSignals();
 
@@ -61,14 +76,53 @@ MainWindow::MainWindow(QWidget* parent)
     // Setup keymap lists
     setupKeymapLists();
 
-    // Load configuration
-    if (!loadCurrentConfig()) {
-        // If config loading fails, disable UI elements
-        setEnabled(false);
-        QMessageBox::critical(
-            this, tr("Configuration Error"),
-            tr("Failed to load configuration. Please check your "
-               "connection to the hazkey server."));
+    // Load configuration; the window shows up while the server starts
+    setBusy(true);
+    server_.getConfig().then(
+        this,
+        [this](std::optional<hazkey::config::CurrentConfig> configOpt) {
+            setBusy(false);
+            if (configOpt.has_value() && configOpt->profiles_size() > 0) {
+                currentConfig_ = configOpt.value();
+                currentProfile_ = currentConfig_.mutable_profiles(0);
+            }
+            if (!currentProfile_ || !loadCurrentConfig()) {
+                // If config loading fails, disable UI elements
+                setEnabled(false);
+                QMessageBox::critical(
+                    this, tr("Configuration Error"),
+                    tr("Failed to load configuration. Please check your "
+                       "connection to the hazkey server."));
+                return;
+            }
+            // the server writes config.json after replying to SetConfig
+            if (!currentConfig_.save_error().empty()) {
+                QMessageBox::warning(
+                    this, tr("Save Error"),
+                    tr("The last configuration could not be written to "
+                       "disk: %1")
+                        .arg(QString::fromStdString(
+                            currentConfig_.save_error())));
+            }
+        });
+}
+
+// Blocks input while a request is in flight instead of freezing the window.
+// Calls nest; Cancel stays usable.
+void MainWindow::setBusy(bool busy) {
+    busyCount_ += busy ? 1 : -1;
+    bool enabled = busyCount_ == 0;
+    if (busy && busyCount_ == 1) {
+        QApplication::setOverrideCursor(Qt::BusyCursor);
+    } else if (enabled) {
+        QApplication::restoreOverrideCursor();
+    }
+    ui_->tabWidget->setEnabled(enabled);
+    for (auto button : {QDialogButtonBox::Ok, QDialogButtonBox::Apply,
+                        QDialogButtonBox::Reset}) {
+        if (QPushButton* pushButton = ui_->dialogButtonBox->button(button)) {
+            pushButton->setEnabled(enabled);
+        }
     }
 }
 
@@ -79,6 +133,14 @@ void MainWindow::connectSignals() {
     connect(ui_->dialogButtonBox, &QDialogButtonBox::clicked, this,
             &MainWindow::onButtonClicked);
 
+    // Connect Zenzai model downloader
+    connect(modelDownloader_, &ModelDownloader::progress, this,
+            &MainWindow::onDownloadProgress);
+    connect(modelDownloader_, &ModelDownloader::finished, this,
+            &MainWindow::onDownloadFinished);
+    connect(modelDownloader_, &ModelDownloader::failed, this,
+            &MainWindow::onDownloadFailed);
+
     // Connect Reset button
     QPushButton* resetButton =
         ui_->dialogButtonBox->button(QDialogButtonBox::Reset);
@@ -153,6 +215,25 @@ void MainWindow::connectSignals() {
     // Connect clear learning data button
     connect(ui_->clearLearningData, &QPushButton::clicked, this,
             &MainWindow::onClearLearningData);
+
+    // Connect diagnostics buttons; the page is also refreshed when shown
+    connect(ui_->refreshDiagnostics, &QPushButton::clicked, this,
+            &MainWindow::onRefreshDiagnostics);
+    connect(ui_->copyDiagnostics, &QPushButton::clicked, this,
+            &MainWindow::onCopyDiagnostics);
+    connect(ui_->tabWidget, &QTabWidget::currentChanged, this, [this]() {
+        if (ui_->tabWidget->currentWidget() == ui_->diagnosticsTab) {
+            onRefreshDiagnostics();
+        }
+    });
+
+    // Connect benchmark controls
+    connect(ui_->runBenchmark, &QPushButton::clicked, this,
+            &MainWindow::onRunBenchmark);
+    connect(ui_->useRecommendedSetting, &QPushButton::clicked, this,
+            &MainWindow::onUseRecommendedSetting);
+    connect(ui_->benchmarkLatencyTarget, &QSpinBox::valueChanged, this,
+            &MainWindow::showBenchmarkResults);
 }
 
 void MainWindow::onButtonClicked(QAbstractButton* button) {
@@ -161,9 +242,7 @@ void MainWindow::onButtonClicked(QAbstractButton* button) {
 
     switch (standardButton) {
         case QDialogButtonBox::Ok:
-            if (saveCurrentConfig()) {
-                close();
-            }
+            saveCurrentConfig(true);
             break;
         case QDialogButtonBox::Apply:
             saveCurrentConfig();
@@ -182,25 +261,7 @@ void MainWindow::onUseHistoryToggled(bool enabled) {
     ui_->stopStoreNewHistory->setEnabled(enabled);
 }
 
-bool MainWindow::loadCurrentConfig(bool fetchConfig) {
-    if (fetchConfig) {
-        auto configOpt = server_.getConfig();
-
-        if (!configOpt.has_value()) {
-            return false;
-        }
-
-        currentConfig_ = configOpt.value();
-        if (currentConfig_.profiles_size() == 0) {
-            return false;
-        }
-
-        currentProfile_ = currentConfig_.mutable_profiles(0);
-        if (!currentProfile_) {
-            return false;
-        }
-    }
-
+bool MainWindow::loadCurrentConfig() {
     // Remove any existing warning widgets on AI tab
     if (ui_->aiTabScrollContentsLayout->count() > 1) {
         QLayoutItem* item = ui_->aiTabScrollContentsLayout->itemAt(1);
@@ -301,6 +362,11 @@ bool MainWindow::loadCurrentConfig(bool fetchConfig) {
     SET_SPINBOX(ui_->zenzaiInferenceLimit,
                 currentProfile_->zenzai_infer_limit(),
                 ConfigDefs::SpinboxDefaults::ZENZAI_INFERENCE_LIMIT);
+    SET_SPINBOX(ui_->longInputChunkLength,
+                currentProfile_->has_long_input_chunk_length()
+                    ? currentProfile_->long_input_chunk_length()
+                    : ConfigDefs::SpinboxDefaults::LONG_INPUT_CHUNK_LENGTH,
+                ConfigDefs::SpinboxDefaults::LONG_INPUT_CHUNK_LENGTH);
 
     SET_CHECKBOX(ui_->useHistory, currentProfile_->use_input_history(),
                  ConfigDefs::CheckboxDefaults::USE_HISTORY);
@@ -376,11 +442,11 @@ bool MainWindow::loadCurrentConfig(bool fetchConfig) {
     return true;
 }
 
-bool MainWindow::saveCurrentConfig() {
+void MainWindow::saveCurrentConfig(bool closeWhenSaved) {
     if (!currentProfile_) {
         QMessageBox::warning(this, tr("Error"),
                              tr("No configuration profile loaded."));
-        return false;
+        return;
     }
 
     currentProfile_->set_auto_convert_mode(
@@ -395,6 +461,8 @@ bool MainWindow::saveCurrentConfig() {
         GET_SPINBOX_INT(ui_->numCandidatesPerPage));
     currentProfile_->set_zenzai_infer_limit(
         GET_SPINBOX_INT(ui_->zenzaiInferenceLimit));
+    currentProfile_->set_long_input_chunk_length(
+        GET_SPINBOX_INT(ui_->longInputChunkLength));
 
     currentProfile_->set_use_input_history(GET_CHECKBOX_BOOL(ui_->useHistory));
     currentProfile_->set_stop_store_new_history(
@@ -439,21 +507,25 @@ bool MainWindow::saveCurrentConfig() {
     // Save keymap configuration
     saveKeymaps();
 
+    // Let the server skip reloading unchanged tables and keymaps
+    saveFileHashes();
+
     // Save to server
-    try {
-        server_.setCurrentConfig(currentConfig_);
-        return true;
-    } catch (const std::exception& e) {
-        QMessageBox::critical(
-            this, tr("Save Error"),
-            tr("Failed to save configuration: %1").arg(e.what()));
-        return false;
-    } catch (...) {
-        QMessageBox::critical(
-            this, tr("Save Error"),
-            tr("An unknown error occurred while saving configuration."));
-        return false;
-    }
+    setBusy(true);
+    server_.setCurrentConfig(currentConfig_)
+        .then(this, [this, closeWhenSaved](bool saved) {
+            setBusy(false);
+            if (!saved) {
+                QMessageBox::critical(
+                    this, tr("Save Error"),
+                    tr("Failed to save configuration. Please check your "
+                       "connection to the hazkey server."));
+                return;
+            }
+            if (closeWhenSaved) {
+                close();
+            }
+        });
 }
 
 void MainWindow::setupInputTableLists() {
@@ -821,6 +893,50 @@ void MainWindow::saveKeymaps() {
     }
 }
 
+void MainWindow::saveFileHashes() {
+    currentConfig_.clear_file_hashes();
+
+    QString configDir =
+        QString::fromStdString(currentConfig_.xdg_config_home_path());
+    if (configDir.isEmpty()) {
+        return;
+    }
+
+    QSet<QString> hashedFiles;
+    auto addFileHash = [&](const std::string& filename, const QString& subDir,
+                           hazkey::config::FileHash::ConfigFileType type) {
+        QString filePath =
+            configDir + "/" + subDir + "/" + QString::fromStdString(filename);
+        if (filename.empty() || hashedFiles.contains(filePath)) {
+            return;
+        }
+        hashedFiles.insert(filePath);
+        QString checksum = calculateFileSHA256(filePath);
+        if (checksum.isEmpty()) {
+            return;
+        }
+        auto* fileHash = currentConfig_.add_file_hashes();
+        fileHash->set_name(filename);
+        fileHash->set_sha256sum(checksum.toStdString());
+        fileHash->set_type(type);
+    };
+
+    for (const auto& profile : currentConfig_.profiles()) {
+        for (const auto& table : profile.enabled_tables()) {
+            if (!table.is_built_in()) {
+                addFileHash(table.filename(), "table",
+                            hazkey::config::FileHash::INPUT_TABLE);
+            }
+        }
+        for (const auto& keymap : profile.enabled_keymaps()) {
+            if (!keymap.is_built_in()) {
+                addFileHash(keymap.filename(), "keymap",
+                            hazkey::config::FileHash::KEYMAP);
+            }
+        }
+    }
+}
+
 void MainWindow::onEnableKeymap() {
     QListWidgetItem* item = ui_->availableKeymapList->currentItem();
     if (!item) {
@@ -1462,19 +1578,361 @@ void MainWindow::onClearLearningData() {
 
     if (reply == QMessageBox::Yes) {
         // Clear the history using the server connector
-        bool success = server_.clearAllHistory(currentProfile_->profile_id());
+        setBusy(true);
+        server_.clearAllHistory(currentProfile_->profile_id())
+            .then(this, [this](bool success) {
+                setBusy(false);
+                if (success) {
+                    QMessageBox::information(
+                        this, tr("Success"),
+                        tr("Input history has been cleared successfully."));
+                } else {
+                    QMessageBox::critical(
+                        this, tr("Error"),
+                        tr("Failed to clear input history. Please check your "
+                           "connection to the hazkey server."));
+                }
+            });
+    }
+}
 
-        if (success) {
-            QMessageBox::information(
-                this, tr("Success"),
-                tr("Input history has been cleared successfully."));
+namespace {
+
+// Upper bound of the histogram bucket holding the p-th request, in ms
+QString histogramPercentile(
+    const hazkey::commands::ServerStats& stats,
+    const hazkey::commands::ServerStats::CommandStats& command, double p) {
+    int64_t target = std::max<int64_t>(1, std::ceil(p * command.count()));
+    int64_t seen = 0;
+    for (int i = 0; i < command.histogram_size(); ++i) {
+        seen += command.histogram(i);
+        if (seen < target) {
+            continue;
+        }
+        if (i < stats.histogram_bounds_us_size()) {
+            return QString::number(stats.histogram_bounds_us(i) / 1000.0);
+        }
+        break;
+    }
+    if (stats.histogram_bounds_us_size() == 0) {
+        return "-";
+    }
+    return ">" + QString::number(stats.histogram_bounds_us(
+                                     stats.histogram_bounds_us_size() - 1) /
+                                 1000.0);
+}
+
+QString formatMiB(int64_t bytes) {
+    return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MiB";
+}
+
+QString formatAverageMs(int64_t totalUs, int64_t count) {
+    if (count == 0) {
+        return "-";
+    }
+    return QString::number(totalUs / 1000.0 / count, 'f', 2) + " ms";
+}
+
+// Plain text so that it can be pasted into a bug report as is
+QString formatServerStats(const hazkey::commands::ServerStats& stats) {
+    QString text;
+    QTextStream out(&text);
+    out << "hazkey " << HAZKEY_VERSION_STR
+        << (stats.in_process() ? " (converter inside fcitx5)" : "") << "\n";
+    out << "uptime: " << QString::number(stats.uptime_ms() / 1000.0, 'f', 1)
+        << " s, rss: " << formatMiB(stats.rss_bytes())
+        << ", learning data: " << formatMiB(stats.learning_data_bytes())
+        << "\n";
+    out << "zenzai: "
+        << (stats.zenzai_available() ? "available" : "not available")
+        << (stats.zenzai_loaded() ? ", loaded" : ", not loaded") << "\n";
+    if (!stats.config_save_error().empty()) {
+        out << "config save error: "
+            << QString::fromStdString(stats.config_save_error()) << "\n";
+    }
+    out << "conversions: lattice only " << stats.lattice_conversions()
+        << " (avg "
+        << formatAverageMs(stats.lattice_time_us(), stats.lattice_conversions())
+        << "), with zenzai " << stats.zenzai_conversions() << " (avg "
+        << formatAverageMs(stats.zenzai_time_us(), stats.zenzai_conversions())
+        << ")\n\n";
+
+    out << QString("%1 %2 %3 %4 %5 %6\n")
+               .arg("command", -24)
+               .arg("count", 8)
+               .arg("avg(ms)", 9)
+               .arg("max(ms)", 9)
+               .arg("p50(ms)", 9)
+               .arg("p99(ms)", 9);
+    for (const auto& command : stats.commands()) {
+        double average = command.count() > 0
+                             ? command.total_us() / 1000.0 / command.count()
+                             : 0;
+        out << QString("%1 %2 %3 %4 %5 %6\n")
+                   .arg(QString::fromStdString(command.command()), -24)
+                   .arg(command.count(), 8)
+                   .arg(average, 9, 'f', 2)
+                   .arg(command.max_us() / 1000.0, 9, 'f', 2)
+                   .arg(histogramPercentile(stats, command, 0.50), 9)
+                   .arg(histogramPercentile(stats, command, 0.99), 9);
+    }
+
+    out << "\ncaches:\n";
+    for (const auto& cache : stats.caches()) {
+        double rate = cache.lookups() > 0
+                          ? 100.0 * cache.hits() / cache.lookups()
+                          : 0;
+        out << "  " << QString::fromStdString(cache.name()) << ": "
+            << cache.hits() << "/" << cache.lookups() << " hits ("
+            << QString::number(rate, 'f', 1) << "%)\n";
+    }
+    return text;
+}
+
+}  // namespace
+
+void MainWindow::onRefreshDiagnostics() {
+    setBusy(true);
+    server_.getStats().then(
+        this,
+        [this](std::optional<hazkey::commands::ServerStats> stats) {
+            setBusy(false);
+            if (!stats) {
+                ui_->diagnosticsText->setPlainText(
+                    tr("Failed to get statistics. Please check your "
+                       "connection to the hazkey server."));
+                return;
+            }
+            ui_->diagnosticsText->setPlainText(formatServerStats(*stats));
+        });
+}
+
+void MainWindow::onCopyDiagnostics() {
+    QGuiApplication::clipboard()->setText(
+        ui_->diagnosticsText->toPlainText());
+}
+
+void MainWindow::onRunBenchmark() {
+    using Setting = hazkey::commands::RunBenchmark::Setting;
+
+    bool zenzaiAvailable =
+        currentConfig_.available_zenzai_backend_devices_size() > 0 &&
+        currentConfig_.zenzai_model_available();
+
+    // The settings on the AI tab, saved or not
+    Setting current;
+    current.set_zenzai_enable(zenzaiAvailable &&
+                              GET_CHECKBOX_BOOL(ui_->enableZenzai));
+    current.set_zenzai_infer_limit(GET_SPINBOX_INT(ui_->zenzaiInferenceLimit));
+    current.set_zenzai_backend_device_name(
+        ui_->zenzaiBackendDevice->currentData().toString().toStdString());
+    current.set_zenzai_contextual_mode(
+        GET_CHECKBOX_BOOL(ui_->zenzaiContextualConversion));
+
+    std::vector<Setting> candidates;
+    Setting lattice;
+    lattice.set_zenzai_enable(false);
+    candidates.push_back(lattice);
+    if (zenzaiAvailable) {
+        Setting zenzai = current;
+        zenzai.set_zenzai_enable(true);
+        for (int limit : {1, 2, 5, 10}) {
+            Setting candidate = zenzai;
+            candidate.set_zenzai_infer_limit(limit);
+            candidates.push_back(candidate);
+        }
+        Setting toggled = zenzai;
+        toggled.set_zenzai_contextual_mode(!zenzai.zenzai_contextual_mode());
+        candidates.push_back(toggled);
+        for (int i = 0; i < ui_->zenzaiBackendDevice->count(); ++i) {
+            Setting candidate = zenzai;
+            candidate.set_zenzai_backend_device_name(
+                ui_->zenzaiBackendDevice->itemData(i).toString().toStdString());
+            candidates.push_back(candidate);
+        }
+    }
+
+    benchmarkRows_.clear();
+    benchmarkRows_.push_back({current, true, {}, false, false, false});
+    for (const auto& candidate : candidates) {
+        bool duplicate = std::any_of(
+            benchmarkRows_.begin(), benchmarkRows_.end(),
+            [&candidate](const BenchmarkRow& row) {
+                if (!row.setting.zenzai_enable() ||
+                    !candidate.zenzai_enable()) {
+                    return row.setting.zenzai_enable() ==
+                           candidate.zenzai_enable();
+                }
+                return row.setting.zenzai_infer_limit() ==
+                           candidate.zenzai_infer_limit() &&
+                       row.setting.zenzai_backend_device_name() ==
+                           candidate.zenzai_backend_device_name() &&
+                       row.setting.zenzai_contextual_mode() ==
+                           candidate.zenzai_contextual_mode();
+            });
+        if (!duplicate) {
+            benchmarkRows_.push_back(
+                {candidate, false, {}, false, false, false});
+        }
+    }
+
+    ui_->runBenchmark->setEnabled(false);
+    ui_->useRecommendedSetting->setEnabled(false);
+    benchmarkPending_ = benchmarkRows_.size();
+    runBenchmarkSample(0, 0, 0);
+    showBenchmarkResults();
+}
+
+// hazkey-server handles nothing else during a request, so every sample is a
+// request of its own and key strokes get through in between. The rows run
+// one after another, so that each loads the model once.
+void MainWindow::runBenchmarkSample(size_t row, int pass, int sample) {
+    // every sample is measured this many times per setting
+    constexpr int BENCHMARK_ITERATIONS = 2;
+
+    hazkey::commands::RunBenchmark request;
+    *request.add_settings() = benchmarkRows_[row].setting;
+    request.set_first_sample(sample);
+    request.set_sample_count(1);
+    request.set_warm_up(pass == 0 && sample == 0);
+    server_.runBenchmark(request).then(
+        this, [this, row, pass, sample](
+                  std::optional<hazkey::commands::BenchmarkResult> result) {
+            auto& current = benchmarkRows_[row];
+            if (result && result->settings_size() == 1) {
+                const auto& setting = result->settings(0);
+                for (int64_t us : setting.latencies_us()) {
+                    current.latenciesMs.push_back(us / 1000.0);
+                }
+                current.zenzaiUsed = setting.zenzai_used();
+                if (sample + 1 < result->sample_set_size()) {
+                    runBenchmarkSample(row, pass, sample + 1);
+                    return;
+                }
+                if (pass + 1 < BENCHMARK_ITERATIONS) {
+                    runBenchmarkSample(row, pass + 1, 0);
+                    return;
+                }
+                current.done = true;
+            } else {
+                current.failed = true;
+            }
+            if (--benchmarkPending_ == 0) {
+                ui_->runBenchmark->setEnabled(true);
+            } else {
+                runBenchmarkSample(row + 1, 0, 0);
+            }
+            showBenchmarkResults();
+        });
+}
+
+// The finished setting with the best expected quality whose p95 latency is
+// within the target: Zenzai over the lattice search, then a higher inference
+// limit, then the contextual mode, then the lower latency.
+std::optional<size_t> MainWindow::recommendedBenchmarkRow() const {
+    double targetMs = ui_->benchmarkLatencyTarget->value();
+    std::optional<size_t> best;
+    auto quality = [](const BenchmarkRow& row) {
+        bool zenzai = row.zenzaiUsed;
+        return std::make_tuple(
+            zenzai, zenzai ? row.setting.zenzai_infer_limit() : 0,
+            zenzai && row.setting.zenzai_contextual_mode(),
+            -percentile(row.latenciesMs, 0.95));
+    };
+    for (size_t i = 0; i < benchmarkRows_.size(); ++i) {
+        const auto& row = benchmarkRows_[i];
+        if (!row.done || percentile(row.latenciesMs, 0.95) > targetMs) {
+            continue;
+        }
+        if (!best || quality(row) > quality(benchmarkRows_[*best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void MainWindow::showBenchmarkResults() {
+    if (benchmarkRows_.empty()) {
+        return;
+    }
+    auto milliseconds = [](double ms) { return QString::number(ms, 'f', 1); };
+
+    QString text;
+    QTextStream out(&text);
+    out << QString("  %1 %2 %3 %4\n")
+               .arg(tr("Setting"), -40)
+               .arg(tr("p50 (ms)"), 9)
+               .arg(tr("p95 (ms)"), 9)
+               .arg(tr("max (ms)"), 9);
+    for (const auto& row : benchmarkRows_) {
+        QString line = QString(row.current ? "* " : "  ") +
+                       QString("%1").arg(benchmarkSettingLabel(row.setting), -40);
+        if (row.done) {
+            line += QString(" %1 %2 %3")
+                        .arg(milliseconds(percentile(row.latenciesMs, 0.50)), 9)
+                        .arg(milliseconds(percentile(row.latenciesMs, 0.95)), 9)
+                        .arg(milliseconds(percentile(row.latenciesMs, 1.0)), 9);
+        } else if (row.failed) {
+            line += " " + tr("failed");
+        } else {
+            line += " " + tr("running...");
+        }
+        out << line << "\n";
+    }
+    out << "\n" << tr("* the current settings on the AI tab") << "\n";
+
+    if (benchmarkPending_ == 0) {
+        auto recommended = recommendedBenchmarkRow();
+        int target = ui_->benchmarkLatencyTarget->value();
+        if (recommended) {
+            out << tr("Best setting within %1 ms: %2")
+                       .arg(target)
+                       .arg(benchmarkSettingLabel(
+                           benchmarkRows_[*recommended].setting))
+                << "\n";
         } else {
-            QMessageBox::critical(
-                this, tr("Error"),
-                tr("Failed to clear input history. Please check your "
-                   "connection to the hazkey server."));
+            out << tr("No setting is within %1 ms.").arg(target) << "\n";
         }
+        ui_->useRecommendedSetting->setEnabled(recommended.has_value());
+    }
+    ui_->benchmarkText->setPlainText(text);
+}
+
+// Fills in the AI tab; the setting is saved with Apply or OK as usual.
+void MainWindow::onUseRecommendedSetting() {
+    auto recommended = recommendedBenchmarkRow();
+    if (!recommended) {
+        return;
+    }
+    const auto& setting = benchmarkRows_[*recommended].setting;
+    ui_->enableZenzai->setChecked(setting.zenzai_enable());
+    if (setting.zenzai_enable()) {
+        ui_->zenzaiInferenceLimit->setValue(setting.zenzai_infer_limit());
+        ui_->zenzaiContextualConversion->setChecked(
+            setting.zenzai_contextual_mode());
+        int index = ui_->zenzaiBackendDevice->findData(
+            QString::fromStdString(setting.zenzai_backend_device_name()));
+        if (index >= 0) {
+            ui_->zenzaiBackendDevice->setCurrentIndex(index);
+        }
+    }
+    ui_->tabWidget->setCurrentWidget(ui_->aiTab);
+}
+
+QString MainWindow::benchmarkSettingLabel(
+    const hazkey::commands::RunBenchmark::Setting& setting) {
+    if (!setting.zenzai_enable()) {
+        return tr("Zenzai off");
+    }
+    QString device =
+        QString::fromStdString(setting.zenzai_backend_device_name());
+    QString label = tr("Zenzai, limit %1, %2")
+                        .arg(setting.zenzai_infer_limit())
+                        .arg(device.isEmpty() ? "CPU" : device);
+    if (setting.zenzai_contextual_mode()) {
+        label += tr(", contextual");
     }
+    return label;
 }
 
 QString MainWindow::translateKeymapName(const QString& keymapName,
@@ -1514,10 +1972,6 @@ QString MainWindow::translateTableName(const QString& tableName,
 }
 
 MainWindow::~MainWindow() {
-    if (currentDownload_) {
-        currentDownload_->abort();
-        currentDownload_->deleteLater();
-    }
     if (downloadProgressDialog_) {
         delete downloadProgressDialog_;
     }
@@ -1525,6 +1979,10 @@ MainWindow::~MainWindow() {
 }
 
 void MainWindow::onDownloadZenzaiModel() {
+    if (modelDownloader_->isRunning()) {
+        return;
+    }
+
     // Determine the download path
     QString dataHome = qEnvironmentVariable("XDG_DATA_HOME");
     if (dataHome.isEmpty()) {
@@ -1559,29 +2017,19 @@ void MainWindow::onDownloadZenzaiModel() {
     downloadProgressDialog_->setMinimumDuration(0);
     downloadProgressDialog_->setValue(0);
 
-    connect(downloadProgressDialog_, &QProgressDialog::canceled, this,
-            [this]() {
-                if (currentDownload_) {
-                    currentDownload_->abort();
-                }
-            });
+    connect(downloadProgressDialog_, &QProgressDialog::canceled,
+            modelDownloader_, &ModelDownloader::abort);
 
-    // Start download
-    QUrl url(
+    // Start download. The URL and checksum can be overridden to test against
+    // a local server.
+    QUrl url(qEnvironmentVariable(
+        "HAZKEY_ZENZAI_MODEL_URL",
         "https://huggingface.co/Miwa-Keita/zenz-v3.1-small-gguf/resolve/main/"
-        "ggml-model-Q5_K_M.gguf");
-    QNetworkRequest request(url);
-
-    currentDownload_ = networkManager_->get(request);
-
-    connect(currentDownload_, &QNetworkReply::downloadProgress, this,
-            &MainWindow::onDownloadProgress);
-    connect(currentDownload_, &QNetworkReply::finished, this,
-            &MainWindow::onDownloadFinished);
-    connect(currentDownload_,
-            QOverload<QNetworkReply::NetworkError>::of(
-                &QNetworkReply::errorOccurred),
-            this, &MainWindow::onDownloadError);
+        "ggml-model-Q5_K_M.gguf"));
+    QString expectedHash = qEnvironmentVariable(
+        "HAZKEY_ZENZAI_MODEL_SHA256",
+        "4de930c06bef8c263aa1aa40684af206db4ce1b96375b3b8ed0ea508e0b14f6c");
+    modelDownloader_->start(url, zenzaiModelPath_, expectedHash);
 }
 
 void MainWindow::onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal) {
@@ -1600,86 +2048,12 @@ void MainWindow::onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal) {
 }
 
 void MainWindow::onDownloadFinished() {
-    if (!currentDownload_) {
-        return;
-    }
-
     // Close progress dialog
     if (downloadProgressDialog_) {
         downloadProgressDialog_->deleteLater();
         downloadProgressDialog_ = nullptr;
     }
 
-    // Check for errors
-    if (currentDownload_->error() != QNetworkReply::NoError) {
-        currentDownload_->deleteLater();
-        currentDownload_ = nullptr;
-        return;  // Error already handled by onDownloadError
-    }
-
-    // Read downloaded data
-    QByteArray downloadedData = currentDownload_->readAll();
-    currentDownload_->deleteLater();
-    currentDownload_ = nullptr;
-
-    // Verify SHA256
-    QCryptographicHash hash(QCryptographicHash::Sha256);
-    hash.addData(downloadedData);
-    QByteArray calculatedHash = hash.result();
-    QString calculatedHashHex = calculatedHash.toHex();
-
-    QString expectedHash =
-        "4de930c06bef8c263aa1aa40684af206db4ce1b96375b3b8ed0ea508e0b14f6c";
-
-    if (calculatedHashHex != expectedHash) {
-        QMessageBox::critical(
-            this, tr("Download Error"),
-            tr("Downloaded file verification failed. Checksum mismatch.\n"
-               "Expected: %1\n"
-               "Got: %2")
-                .arg(expectedHash)
-                .arg(calculatedHashHex));
-        return;
-    }
-
-    // Save to temporary file first
-    QString tempPath = zenzaiModelPath_ + ".tmp";
-    QFile tempFile(tempPath);
-    if (!tempFile.open(QIODevice::WriteOnly)) {
-        QMessageBox::critical(
-            this, tr("Download Error"),
-            tr("Failed to save model file: %1").arg(tempFile.errorString()));
-        return;
-    }
-
-    if (tempFile.write(downloadedData) == -1) {
-        QMessageBox::critical(
-            this, tr("Download Error"),
-            tr("Failed to write model file: %1").arg(tempFile.errorString()));
-        tempFile.close();
-        QFile::remove(tempPath);
-        return;
-    }
-
-    tempFile.close();
-
-    // Remove old file if it exists and rename temp file
-    if (QFile::exists(zenzaiModelPath_)) {
-        if (!QFile::remove(zenzaiModelPath_)) {
-            QMessageBox::critical(this, tr("Download Error"),
-                                  tr("Failed to remove old model file."));
-            QFile::remove(tempPath);
-            return;
-        }
-    }
-
-    if (!QFile::rename(tempPath, zenzaiModelPath_)) {
-        QMessageBox::critical(this, tr("Download Error"),
-                              tr("Failed to rename model file."));
-        QFile::remove(tempPath);
-        return;
-    }
-
     // Reload Zenzai model in server
     server_.reloadZenzaiModel();
 
@@ -1689,26 +2063,18 @@ void MainWindow::onDownloadFinished() {
            "Please push 'Reset' to refresh the UI."));
 }
 
-void MainWindow::onDownloadError(QNetworkReply::NetworkError error) {
+void MainWindow::onDownloadFailed(const QString& message, bool canceled) {
     // Close progress dialog first
     if (downloadProgressDialog_) {
         downloadProgressDialog_->deleteLater();
         downloadProgressDialog_ = nullptr;
     }
 
-    if (!currentDownload_) {
-        return;
-    }
-
-    QString errorString = currentDownload_->errorString();
-    currentDownload_->deleteLater();
-    currentDownload_ = nullptr;
-
-    // Don't show error if user cancelled
-    if (error != QNetworkReply::OperationCanceledError) {
+    // Don't show error if user cancelled; the partial file is resumed later
+    if (!canceled) {
         QMessageBox::critical(
             this, tr("Download Error"),
-            tr("Failed to download Zenzai model: %1").arg(errorString));
+            tr("Failed to download Zenzai model: %1").arg(message));
     }
 }
 
@@ -1722,56 +2088,53 @@ void MainWindow::onResetConfiguration() {
         return;
     }
 
-    // Use a persistent session to avoid connection conflicts
-    if (!server_.beginSession()) {
-        QMessageBox::critical(this, tr("Connection Error"),
-                              tr("Failed to connect to server."));
-        return;
-    }
-
-    // Reload Zenzai model using the session
-    bool reloadSuccess = server_.reloadZenzaiModelInSession();
-    if (!reloadSuccess) {
-        qWarning() << "Failed to reload Zenzai model";
-    }
-
-    // Get config using the same session
-    auto configOpt = server_.getConfigInSession();
-    server_.endSession();
+    // Requests run in order, so the config is read after the reload
+    server_.reloadZenzaiModel().then(this, [](bool reloaded) {
+        if (!reloaded) {
+            qWarning() << "Failed to reload Zenzai model";
+        }
+    });
 
-    if (!configOpt.has_value()) {
-        QMessageBox::critical(this, tr("Configuration Error"),
-                              tr("Failed to load configuration from server."));
-        return;
-    }
+    setBusy(true);
+    server_.getConfig().then(
+        this,
+        [this](std::optional<hazkey::config::CurrentConfig> configOpt) {
+            setBusy(false);
+            if (!configOpt.has_value()) {
+                QMessageBox::critical(
+                    this, tr("Configuration Error"),
+                    tr("Failed to load configuration from server."));
+                return;
+            }
 
-    // Update UI with the loaded config
-    currentConfig_ = configOpt.value();
-    if (currentConfig_.profiles_size() == 0) {
-        QMessageBox::critical(this, tr("Configuration Error"),
-                              tr("No profile found in configuration."));
-        return;
-    }
+            // Update UI with the loaded config
+            currentConfig_ = configOpt.value();
+            if (currentConfig_.profiles_size() == 0) {
+                currentProfile_ = nullptr;
+                QMessageBox::critical(
+                    this, tr("Configuration Error"),
+                    tr("No profile found in configuration."));
+                return;
+            }
 
-    currentProfile_ = currentConfig_.mutable_profiles(0);
-    if (!currentProfile_) {
-        QMessageBox::critical(this, tr("Configuration Error"),
-                              tr("Failed to access profile."));
-        return;
-    }
+            currentProfile_ = currentConfig_.mutable_profiles(0);
+            if (!currentProfile_) {
+                QMessageBox::critical(this, tr("Configuration Error"),
+                                      tr("Failed to access profile."));
+                return;
+            }
 
-    // Reload all UI components (skip fetching config since we already have it)
-    if (!loadCurrentConfig(false)) {
-        QMessageBox::critical(this, tr("Configuration Error"),
-                              tr("Failed to update UI."));
-        return;
-    }
+            // Reload all UI components
+            if (!loadCurrentConfig()) {
+                QMessageBox::critical(this, tr("Configuration Error"),
+                                      tr("Failed to update UI."));
+                return;
+            }
 
-    QTimer::singleShot(0, this, [this]() {
-        QMessageBox::information(
-            this, tr("Reset Complete"),
-            tr("Configuration has been reset successfully."));
-    });
+            QMessageBox::information(
+                this, tr("Reset Complete"),
+                tr("Configuration has been reset successfully."));
+        });
 }
 
 QWidget* MainWindow::createWarningWidget(const QString& message,
@@ -3,10 +3,12 @@
 
 #include <QAbstractButton>
 #include <QNetworkAccessManager>
-#include <QNetworkReply>
 #include <QProgressDialog>
 #include <QWidget>
+#include <optional>
+#include <vector>
 
+#include "modeldownloader.h"
 #include "serverconnector.h"
 
 QT_BEGIN_NAMESPACE
@@ -48,13 +50,19 @@ class MainWindow : public QWidget {
     void onDownloadZenzaiModel();
     void onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
     void onDownloadFinished();
-    void onDownloadError(QNetworkReply::NetworkError error);
+    void onDownloadFailed(const QString& message, bool canceled);
     void onResetConfiguration();
+    void onRefreshDiagnostics();
+    void onCopyDiagnostics();
+    void onRunBenchmark();
+    void onUseRecommendedSetting();
+    void showBenchmarkResults();
 
    private:
     void connectSignals();
-    bool loadCurrentConfig(bool fetchConfig = true);
-    bool saveCurrentConfig();
+    void setBusy(bool busy);
+    bool loadCurrentConfig();
+    void saveCurrentConfig(bool closeWhenSaved = false);
     void setupInputTableLists();
     void loadInputTables();
     void saveInputTables();
@@ -62,6 +70,7 @@ class MainWindow : public QWidget {
     void setupKeymapLists();
     void loadKeymaps();
     void saveKeymaps();
+    void saveFileHashes();
     void updateKeymapButtonStates();
     void syncBasicToAdvanced();
     void syncAdvancedToBasic();
@@ -80,6 +89,10 @@ class MainWindow : public QWidget {
     QString translateKeymapName(const QString& keymapName, bool isBuiltin);
     QString translateTableName(const QString& tableName, bool isBuiltin);
     QString calculateFileSHA256(const QString& filePath);
+    void runBenchmarkSample(size_t row, int pass, int sample);
+    std::optional<size_t> recommendedBenchmarkRow() const;
+    QString benchmarkSettingLabel(
+        const hazkey::commands::RunBenchmark::Setting& setting);
     QWidget* createWarningWidget(
         const QString& message, const QString& backgroundColor,
         const QString& buttonText = QString(),
@@ -90,8 +103,21 @@ class MainWindow : public QWidget {
     hazkey::config::Profile* currentProfile_;
     bool isUpdatingFromAdvanced_;
     QNetworkAccessManager* networkManager_;
-    QNetworkReply* currentDownload_;
+    ModelDownloader* modelDownloader_;
     QProgressDialog* downloadProgressDialog_;
     QString zenzaiModelPath_;
+    int busyCount_;
+
+    struct BenchmarkRow {
+        hazkey::commands::RunBenchmark::Setting setting;
+        // the settings on the AI tab when the benchmark was started
+        bool current;
+        std::vector<double> latenciesMs;
+        bool zenzaiUsed;
+        bool done;
+        bool failed;
+    };
+    std::vector<BenchmarkRow> benchmarkRows_;
+    size_t benchmarkPending_;
 };
 #endif  // MAINWINDOW_H
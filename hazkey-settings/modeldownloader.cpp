@@ -0,0 +1,250 @@
+#include "modeldownloader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <QFileInfo>
+#include <QNetworkRequest>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Makes the rename of a file in `dir` durable.
+void syncDirectory(const QString& dir) {
+    int fd = open(QFile::encodeName(dir).constData(),
+                  O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+}  // namespace
+
+ModelDownloader::ModelDownloader(QNetworkAccessManager* networkManager,
+                                 QObject* parent)
+    : QObject(parent), networkManager_(networkManager) {}
+
+ModelDownloader::~ModelDownloader() {
+    if (reply_) {
+        reply_->disconnect(this);
+        reply_->abort();
+        reply_->deleteLater();
+    }
+}
+
+void ModelDownloader::start(const QUrl& url, const QString& path,
+                            const QString& expectedSha256) {
+    if (reply_) {
+        return;
+    }
+    url_ = url;
+    path_ = path;
+    tempPath_ = path + ".tmp";
+    expectedSha256_ = expectedSha256.toLower();
+    restarted_ = false;
+
+    if (!openPartialFile()) {
+        emit failed(tr("Failed to open %1: %2")
+                        .arg(tempPath_, tempFile_.errorString()),
+                    false);
+        return;
+    }
+    sendRequest();
+}
+
+void ModelDownloader::abort() {
+    if (reply_) {
+        // keep the .tmp file to resume from
+        fail(tr("Download canceled."), true);
+    }
+}
+
+// Opens the .tmp file without truncating it and hashes what is already
+// there, so the download can continue after it.
+bool ModelDownloader::openPartialFile() {
+    tempFile_.close();
+    tempFile_.setFileName(tempPath_);
+    if (!tempFile_.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    hash_.reset();
+    if (!hash_.addData(&tempFile_)) {
+        tempFile_.close();
+        return false;
+    }
+    resumeOffset_ = tempFile_.size();
+    return tempFile_.seek(resumeOffset_);
+}
+
+void ModelDownloader::sendRequest() {
+    QNetworkRequest request(url_);
+    if (resumeOffset_ > 0) {
+        request.setRawHeader("Range",
+                             QByteArray("bytes=") +
+                                 QByteArray::number(resumeOffset_) + "-");
+    }
+    statusChecked_ = false;
+    acceptBody_ = false;
+
+    reply_ = networkManager_->get(request);
+    connect(reply_, &QNetworkReply::readyRead, this,
+            &ModelDownloader::onReadyRead);
+    connect(reply_, &QNetworkReply::downloadProgress, this,
+            &ModelDownloader::onDownloadProgress);
+    connect(reply_, &QNetworkReply::finished, this,
+            &ModelDownloader::onReplyFinished);
+}
+
+// Decides from the status code whether the body continues the .tmp file.
+bool ModelDownloader::checkStatus() {
+    statusChecked_ = true;
+    int status =
+        reply_->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 206) {
+        QByteArray expectedRange = QByteArray("bytes ") +
+                                   QByteArray::number(resumeOffset_) + "-";
+        return reply_->rawHeader("Content-Range").startsWith(expectedRange);
+    }
+    if (status == 200) {
+        if (resumeOffset_ > 0) {
+            // the server ignored the Range header and sends everything
+            tempFile_.resize(0);
+            tempFile_.seek(0);
+            hash_.reset();
+            resumeOffset_ = 0;
+        }
+        return true;
+    }
+    return false;
+}
+
+void ModelDownloader::onReadyRead() {
+    if (!reply_) {
+        return;
+    }
+    if (!statusChecked_) {
+        acceptBody_ = checkStatus();
+    }
+    QByteArray chunk = reply_->readAll();
+    if (!acceptBody_ || chunk.isEmpty()) {
+        return;
+    }
+    if (tempFile_.write(chunk) != chunk.size()) {
+        fail(tr("Failed to write %1: %2")
+                 .arg(tempPath_, tempFile_.errorString()));
+        return;
+    }
+    hash_.addData(chunk);
+}
+
+void ModelDownloader::onDownloadProgress(qint64 bytesReceived,
+                                         qint64 bytesTotal) {
+    emit progress(resumeOffset_ + bytesReceived,
+                  bytesTotal > 0 ? resumeOffset_ + bytesTotal : -1);
+}
+
+void ModelDownloader::onReplyFinished() {
+    if (!reply_) {
+        return;
+    }
+    int status =
+        reply_->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 416 && resumeOffset_ > 0) {
+        // Nothing left to send: the .tmp file is either complete or does
+        // not belong to this file. Check it, or start over once.
+        reply_->deleteLater();
+        reply_ = nullptr;
+        QString errorMessage;
+        if (hash_.result().toHex() == expectedSha256_.toLatin1()) {
+            if (finishFile(&errorMessage)) {
+                emit finished();
+            } else {
+                emit failed(errorMessage, false);
+            }
+            return;
+        }
+        if (!restarted_) {
+            restarted_ = true;
+            tempFile_.resize(0);
+            tempFile_.seek(0);
+            hash_.reset();
+            resumeOffset_ = 0;
+            sendRequest();
+            return;
+        }
+        tempFile_.close();
+        emit failed(tr("The server rejected the download range."), false);
+        return;
+    }
+
+    if (reply_->error() != QNetworkReply::NoError) {
+        fail(reply_->errorString());
+        return;
+    }
+    onReadyRead();
+    if (!reply_) {
+        return;
+    }
+    if (!acceptBody_) {
+        if (status == 206) {
+            // a range other than the one asked for; start over next time
+            tempFile_.close();
+            QFile::remove(tempPath_);
+        }
+        fail(tr("Unexpected HTTP status %1.").arg(status));
+        return;
+    }
+
+    reply_->deleteLater();
+    reply_ = nullptr;
+    QString errorMessage;
+    if (finishFile(&errorMessage)) {
+        emit finished();
+    } else {
+        emit failed(errorMessage, false);
+    }
+}
+
+// Verifies the hash, syncs the .tmp file and renames it over `path_`.
+bool ModelDownloader::finishFile(QString* errorMessage) {
+    tempFile_.flush();
+    fsync(tempFile_.handle());
+    tempFile_.close();
+
+    QByteArray calculated = hash_.result().toHex();
+    if (calculated != expectedSha256_.toLatin1()) {
+        // a corrupt file would be resumed forever
+        QFile::remove(tempPath_);
+        *errorMessage =
+            tr("Downloaded file verification failed. Checksum mismatch.\n"
+               "Expected: %1\n"
+               "Got: %2")
+                .arg(expectedSha256_, QString::fromLatin1(calculated));
+        return false;
+    }
+
+    // replaces the old model atomically, unlike QFile::rename
+    if (std::rename(QFile::encodeName(tempPath_).constData(),
+                    QFile::encodeName(path_).constData()) != 0) {
+        *errorMessage = tr("Failed to rename model file: %1")
+                            .arg(QString::fromLocal8Bit(strerror(errno)));
+        return false;
+    }
+    syncDirectory(QFileInfo(path_).absolutePath());
+    return true;
+}
+
+void ModelDownloader::fail(const QString& message, bool canceled) {
+    QNetworkReply* reply = reply_;
+    reply_ = nullptr;
+    if (reply) {
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+    tempFile_.close();
+    emit failed(message, canceled);
+}
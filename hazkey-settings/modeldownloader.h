@@ -0,0 +1,65 @@
+#ifndef MODELDOWNLOADER_H
+#define MODELDOWNLOADER_H
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+
+// Downloads a file to `path` through `path.tmp`, writing and hashing the
+// data as it arrives, so memory use does not grow with the file size. If a
+// download is interrupted or canceled, the .tmp file is kept and the next
+// download resumes it with an HTTP Range request. The finished file is
+// checked against its SHA-256, synced and renamed into place atomically.
+class ModelDownloader : public QObject {
+    Q_OBJECT
+
+   public:
+    explicit ModelDownloader(QNetworkAccessManager* networkManager,
+                             QObject* parent = nullptr);
+    ~ModelDownloader();
+
+    // Emits finished() or failed() once. Ignored while a download runs.
+    void start(const QUrl& url, const QString& path,
+               const QString& expectedSha256);
+    void abort();
+    bool isRunning() const { return reply_ != nullptr; }
+
+   signals:
+    // bytes of the whole file, including a resumed part
+    void progress(qint64 bytesReceived, qint64 bytesTotal);
+    void finished();
+    void failed(const QString& message, bool canceled);
+
+   private slots:
+    void onReadyRead();
+    void onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
+    void onReplyFinished();
+
+   private:
+    bool openPartialFile();
+    void sendRequest();
+    bool checkStatus();
+    bool finishFile(QString* errorMessage);
+    void fail(const QString& message, bool canceled = false);
+
+    QNetworkAccessManager* networkManager_;
+    QNetworkReply* reply_ = nullptr;
+    QUrl url_;
+    QString path_;
+    QString tempPath_;
+    QString expectedSha256_;
+    QFile tempFile_;
+    QCryptographicHash hash_{QCryptographicHash::Sha256};
+    // bytes already in the .tmp file when the request was sent
+    qint64 resumeOffset_ = 0;
+    bool statusChecked_ = false;
+    // whether the response body belongs in the .tmp file
+    bool acceptBody_ = false;
+    bool restarted_ = false;
+};
+
+#endif  // MODELDOWNLOADER_H
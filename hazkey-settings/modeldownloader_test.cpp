@@ -0,0 +1,274 @@
+// Runs ModelDownloader against a local HTTP stand-in on a QTcpServer: a
+// resumed download (206), a server that ignores Range (200), a complete or
+// foreign .tmp file (416) and a hash mismatch.
+//
+// usage: hazkey-settings-downloader-test
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QEventLoop>
+#include <QFile>
+#include <QHostAddress>
+#include <QNetworkAccessManager>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modeldownloader.h"
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::fprintf(stderr, "  FAILED: %s\n", what.c_str());
+        ++failures;
+    }
+}
+
+QByteArray payload() {
+    QByteArray data;
+    for (int i = 0; i < 100000; ++i) {
+        data.append(static_cast<char>(i * 7 % 251));
+    }
+    return data;
+}
+
+QString sha256(const QByteArray& data) {
+    return QString::fromLatin1(
+        QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+}
+
+QByteArray response(const QByteArray& status,
+                    const std::vector<QByteArray>& headers,
+                    const QByteArray& body) {
+    QByteArray text = "HTTP/1.1 " + status + "\r\n";
+    for (const auto& header : headers) {
+        text += header + "\r\n";
+    }
+    text += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    text += "Connection: close\r\n\r\n";
+    return text + body;
+}
+
+// Answers every request with `handler(range)`, where `range` is the value of
+// the Range header or empty, and records the ranges asked for.
+class HttpStandIn {
+   public:
+    using Handler = std::function<QByteArray(const QByteArray& range)>;
+
+    explicit HttpStandIn(Handler handler) : handler_(std::move(handler)) {
+        server_.listen(QHostAddress::LocalHost);
+        QObject::connect(&server_, &QTcpServer::newConnection, &server_,
+                         [this] { accept(); });
+    }
+
+    QUrl url() const {
+        return QUrl(QString("http://127.0.0.1:%1/model.gguf")
+                        .arg(server_.serverPort()));
+    }
+    const std::vector<QByteArray>& ranges() const { return ranges_; }
+
+   private:
+    void accept() {
+        while (QTcpSocket* socket = server_.nextPendingConnection()) {
+            auto buffer = std::make_shared<QByteArray>();
+            QObject::connect(socket, &QTcpSocket::readyRead, socket,
+                             [this, socket, buffer] {
+                                 *buffer += socket->readAll();
+                                 if (buffer->contains("\r\n\r\n")) {
+                                     answer(socket, *buffer);
+                                 }
+                             });
+            QObject::connect(socket, &QTcpSocket::disconnected, socket,
+                             &QObject::deleteLater);
+        }
+    }
+
+    void answer(QTcpSocket* socket, const QByteArray& request) {
+        QByteArray range;
+        for (const auto& line : request.split('\n')) {
+            if (line.toLower().startsWith("range:")) {
+                range = line.mid(6).trimmed();
+            }
+        }
+        ranges_.push_back(range);
+        socket->write(handler_(range));
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer server_;
+    Handler handler_;
+    std::vector<QByteArray> ranges_;
+};
+
+struct Outcome {
+    bool finished = false;
+    bool failed = false;
+    QString message;
+};
+
+Outcome download(const QUrl& url, const QString& path,
+                 const QString& expectedSha256) {
+    QNetworkAccessManager networkManager;
+    ModelDownloader downloader(&networkManager);
+    Outcome outcome;
+    QEventLoop loop;
+    QObject::connect(&downloader, &ModelDownloader::finished, &loop, [&] {
+        outcome.finished = true;
+        loop.quit();
+    });
+    QObject::connect(&downloader, &ModelDownloader::failed, &loop,
+                     [&](const QString& message, bool) {
+                         outcome.failed = true;
+                         outcome.message = message;
+                         loop.quit();
+                     });
+    QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+    downloader.start(url, path, expectedSha256);
+    if (!outcome.finished && !outcome.failed) {
+        loop.exec();
+    }
+    return outcome;
+}
+
+void writeFile(const QString& path, const QByteArray& data) {
+    QFile file(path);
+    file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    file.write(data);
+}
+
+QByteArray readFile(const QString& path) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+// Serves byte ranges like a static file server.
+QByteArray serveRange(const QByteArray& data, const QByteArray& range) {
+    if (range.isEmpty()) {
+        return response("200 OK", {}, data);
+    }
+    qint64 start = range.mid(6, range.indexOf('-') - 6).toLongLong();
+    if (start >= data.size()) {
+        return response(
+            "416 Range Not Satisfiable",
+            {"Content-Range: bytes */" + QByteArray::number(data.size())}, {});
+    }
+    return response("206 Partial Content",
+                    {"Content-Range: bytes " + QByteArray::number(start) + "-" +
+                     QByteArray::number(data.size() - 1) + "/" +
+                     QByteArray::number(data.size())},
+                    data.mid(start));
+}
+
+void testResume(const QString& dir) {
+    const QByteArray data = payload();
+    const QString path = dir + "/resume.gguf";
+    writeFile(path + ".tmp", data.left(30000));
+    HttpStandIn server(
+        [&](const QByteArray& range) { return serveRange(data, range); });
+
+    auto outcome = download(server.url(), path, sha256(data));
+    expect(outcome.finished, "resumed download finishes");
+    expect(server.ranges().size() == 1 &&
+               server.ranges()[0] == "bytes=30000-",
+           "the request resumes after the partial file");
+    expect(readFile(path) == data, "resumed file is complete");
+    expect(!QFile::exists(path + ".tmp"), ".tmp file is renamed");
+}
+
+void testRangeIgnored(const QString& dir) {
+    const QByteArray data = payload();
+    const QString path = dir + "/ignored.gguf";
+    // not a prefix of the file, so appending to it would corrupt the result
+    writeFile(path + ".tmp", QByteArray(30000, 'x'));
+    HttpStandIn server([&](const QByteArray&) {
+        return response("200 OK", {}, data);
+    });
+
+    auto outcome = download(server.url(), path, sha256(data));
+    expect(outcome.finished, "download without Range support finishes");
+    expect(readFile(path) == data,
+           "the partial file is replaced, not appended to");
+}
+
+void testCompleteTempFile(const QString& dir) {
+    const QByteArray data = payload();
+    const QString path = dir + "/complete.gguf";
+    writeFile(path + ".tmp", data);
+    HttpStandIn server(
+        [&](const QByteArray& range) { return serveRange(data, range); });
+
+    auto outcome = download(server.url(), path, sha256(data));
+    expect(outcome.finished, "416 with a complete .tmp file finishes");
+    expect(server.ranges().size() == 1, "no second request is sent");
+    expect(readFile(path) == data, "the complete .tmp file is used");
+}
+
+void testForeignTempFile(const QString& dir) {
+    const QByteArray data = payload();
+    const QString path = dir + "/foreign.gguf";
+    // as long as the file, so the range is unsatisfiable, but other data
+    writeFile(path + ".tmp", QByteArray(data.size(), 'x'));
+    HttpStandIn server(
+        [&](const QByteArray& range) { return serveRange(data, range); });
+
+    auto outcome = download(server.url(), path, sha256(data));
+    expect(outcome.finished, "416 with a foreign .tmp file starts over");
+    expect(server.ranges().size() == 2 && server.ranges()[1].isEmpty(),
+           "the second request asks for the whole file");
+    expect(readFile(path) == data, "the file is downloaded again");
+}
+
+void testHashMismatch(const QString& dir) {
+    const QByteArray data = payload();
+    const QString path = dir + "/mismatch.gguf";
+    HttpStandIn server(
+        [&](const QByteArray& range) { return serveRange(data, range); });
+
+    auto outcome = download(server.url(), path, sha256("other data"));
+    expect(outcome.failed, "hash mismatch fails");
+    expect(outcome.message.contains("Checksum mismatch"),
+           "the failure names the checksum");
+    expect(!QFile::exists(path), "no model file is created");
+    expect(!QFile::exists(path + ".tmp"),
+           "the corrupt .tmp file is not kept for resuming");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::fprintf(stderr, "Failed to create a temporary directory\n");
+        return 1;
+    }
+
+    const std::vector<std::pair<const char*, std::function<void()>>> tests = {
+        {"resume (206)", [&] { testResume(dir.path()); }},
+        {"range ignored (200)", [&] { testRangeIgnored(dir.path()); }},
+        {"complete .tmp (416)", [&] { testCompleteTempFile(dir.path()); }},
+        {"foreign .tmp (416)", [&] { testForeignTempFile(dir.path()); }},
+        {"hash mismatch", [&] { testHashMismatch(dir.path()); }},
+    };
+    for (const auto& [name, test] : tests) {
+        std::fprintf(stderr, "%s\n", name);
+        test();
+    }
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::fprintf(stderr, "all checks passed\n");
+    return 0;
+}
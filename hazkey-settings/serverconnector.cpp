@@ -13,19 +13,38 @@
 #include <QDir>
 #include <QMessageBox>
 #include <QProcess>
+#include <QPromise>
 #include <chrono>
 #include <fstream>
-#include <mutex>
+#include <memory>
 #include <thread>
 
 #include "qdir.h"
 #include "qlogging.h"
 
-static std::mutex transact_mutex;
+ServerConnector::ServerConnector() : socket_(-1) {
+    // a single thread keeps requests in order and owns the connection
+    worker_.setMaxThreadCount(1);
+    worker_.setExpiryTimeout(-1);
+}
 
-ServerConnector::ServerConnector() : session_socket_(-1) {}
+ServerConnector::~ServerConnector() {
+    worker_.waitForDone();
+    closeConnection();
+}
 
-ServerConnector::~ServerConnector() { endSession(); }
+template <typename Job>
+auto ServerConnector::enqueue(Job job) -> QFuture<decltype(job())> {
+    using Result = decltype(job());
+    auto promise = std::make_shared<QPromise<Result>>();
+    QFuture<Result> future = promise->future();
+    promise->start();
+    worker_.start([promise, job = std::move(job)]() {
+        promise->addResult(job());
+        promise->finish();
+    });
+    return future;
+}
 
 std::string ServerConnector::getSocketPath() {
     const char* xdg_runtime_dir = std::getenv("XDG_RUNTIME_DIR");
@@ -41,7 +60,9 @@ std::string ServerConnector::getSocketPath() {
 bool writeAll(int fd, const void* data, size_t len) {
     size_t sent = 0;
     while (sent < len) {
-        ssize_t n = write(fd, (const char*)data + sent, len - sent);
+        // the server may have dropped the connection; don't die of SIGPIPE
+        ssize_t n = send(fd, (const char*)data + sent, len - sent,
+                         MSG_NOSIGNAL);
         if (n < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
                 fd_set wfds;
@@ -61,7 +82,7 @@ bool writeAll(int fd, const void* data, size_t len) {
     return true;
 }
 
-bool readAll(int fd, void* data, size_t len) {
+bool readAll(int fd, void* data, size_t len, int timeoutSec) {
     size_t recved = 0;
     while (recved < len) {
         ssize_t n = read(fd, (char*)data + recved, len - recved);
@@ -70,7 +91,7 @@ bool readAll(int fd, void* data, size_t len) {
                 fd_set rfds;
                 FD_ZERO(&rfds);
                 FD_SET(fd, &rfds);
-                timeval tv = {10, 0};  // 2sec timeout
+                timeval tv = {timeoutSec, 0};
                 int r = select(fd + 1, &rfds, NULL, NULL, &tv);
                 if (r <= 0) {
                     return false;
@@ -152,7 +173,7 @@ int ServerConnector::createConnection() {
 }
 
 std::optional<hazkey::ResponseEnvelope> ServerConnector::transactOnSocket(
-    int sock, const hazkey::RequestEnvelope& send_data) {
+    int sock, const hazkey::RequestEnvelope& send_data, int timeoutSec) {
     std::string msg;
     if (!send_data.SerializeToString(&msg)) {
         return std::nullopt;
@@ -171,7 +192,7 @@ std::optional<hazkey::ResponseEnvelope> ServerConnector::transactOnSocket(
 
     // read response length
     uint32_t readLenBuf;
-    if (!readAll(sock, &readLenBuf, 4)) {
+    if (!readAll(sock, &readLenBuf, 4, timeoutSec)) {
         return std::nullopt;
     }
 
@@ -183,7 +204,7 @@ std::optional<hazkey::ResponseEnvelope> ServerConnector::transactOnSocket(
 
     // read response
     std::vector<char> buf(readLen);
-    if (!readAll(sock, buf.data(), readLen)) {
+    if (!readAll(sock, buf.data(), readLen, timeoutSec)) {
         return std::nullopt;
     }
 
@@ -195,137 +216,142 @@ std::optional<hazkey::ResponseEnvelope> ServerConnector::transactOnSocket(
     return resp;
 }
 
-std::optional<hazkey::ResponseEnvelope> ServerConnector::transact(
-    const hazkey::RequestEnvelope& send_data) {
-    std::lock_guard<std::mutex> lock(transact_mutex);
-
-    // Create new connection for each transaction
-    int sock = createConnection();
-    if (sock == -1) {
-        return std::nullopt;
-    }
-
-    auto resp = transactOnSocket(sock, send_data);
-
-    // Close connection after transaction
-    close(sock);
-    return resp;
-}
-
-bool ServerConnector::beginSession() {
-    std::lock_guard<std::mutex> lock(transact_mutex);
-
-    // Close existing session if any
-    if (session_socket_ != -1) {
-        close(session_socket_);
-        session_socket_ = -1;
-    }
-
-    session_socket_ = createConnection();
-    return session_socket_ != -1;
+// Checks that the server has not closed the kept connection, which it does
+// when another client connects or when it restarts.
+bool ServerConnector::connectionAlive() {
+    char byte;
+    ssize_t n = recv(socket_, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
 }
 
-void ServerConnector::endSession() {
-    std::lock_guard<std::mutex> lock(transact_mutex);
-
-    if (session_socket_ != -1) {
-        close(session_socket_);
-        session_socket_ = -1;
+void ServerConnector::closeConnection() {
+    if (socket_ != -1) {
+        close(socket_);
+        socket_ = -1;
     }
 }
 
-std::optional<hazkey::config::CurrentConfig>
-ServerConnector::getConfigInSession() {
-    std::lock_guard<std::mutex> lock(transact_mutex);
-
-    if (session_socket_ == -1) {
-        return std::nullopt;
-    }
-
-    hazkey::RequestEnvelope request;
-    auto _ = request.mutable_get_config();
-    auto response = transactOnSocket(session_socket_, request);
-    if (response == std::nullopt) {
-        return std::nullopt;
-    }
-    auto responseVal = response.value();
-    if (responseVal.status() != hazkey::SUCCESS) {
-        return std::nullopt;
-    }
-    if (!responseVal.has_current_config()) {
-        return std::nullopt;
+std::optional<hazkey::ResponseEnvelope> ServerConnector::transact(
+    const hazkey::RequestEnvelope& send_data, int timeoutSec) {
+    if (socket_ != -1 && !connectionAlive()) {
+        closeConnection();
     }
-    return responseVal.current_config();
-}
-
-bool ServerConnector::reloadZenzaiModelInSession() {
-    std::lock_guard<std::mutex> lock(transact_mutex);
-
-    if (session_socket_ == -1) {
-        return false;
+    if (socket_ == -1) {
+        socket_ = createConnection();
+        if (socket_ == -1) {
+            return std::nullopt;
+        }
     }
 
-    hazkey::RequestEnvelope request;
-    auto _ = request.mutable_reload_zenzai_model();
-    auto response = transactOnSocket(session_socket_, request);
-    if (response == std::nullopt) {
-        return false;
+    auto resp = transactOnSocket(socket_, send_data, timeoutSec);
+    if (resp == std::nullopt) {
+        // the stream may be out of sync; start over on the next request
+        closeConnection();
     }
-    auto responseVal = response.value();
-    return responseVal.status() == hazkey::SUCCESS;
+    return resp;
 }
 
-std::optional<hazkey::config::CurrentConfig> ServerConnector::getConfig() {
-    hazkey::RequestEnvelope request;
-    auto _ = request.mutable_get_config();
-    auto response = transact(request);
-    if (response == std::nullopt) {
-        return std::nullopt;
-    }
-    auto responseVal = response.value();
-    if (responseVal.status() != hazkey::SUCCESS) {
-        return std::nullopt;
-    }
-    if (!responseVal.has_current_config()) {
-        return std::nullopt;
-    }
-    return responseVal.current_config();
+QFuture<std::optional<hazkey::config::CurrentConfig>>
+ServerConnector::getConfig() {
+    return enqueue(
+        [this]() -> std::optional<hazkey::config::CurrentConfig> {
+            hazkey::RequestEnvelope request;
+            auto _ = request.mutable_get_config();
+            auto response = transact(request);
+            if (response == std::nullopt) {
+                return std::nullopt;
+            }
+            auto responseVal = response.value();
+            if (responseVal.status() != hazkey::SUCCESS) {
+                return std::nullopt;
+            }
+            if (!responseVal.has_current_config()) {
+                return std::nullopt;
+            }
+            return responseVal.current_config();
+        });
 }
 
-void ServerConnector::setCurrentConfig(
+QFuture<bool> ServerConnector::setCurrentConfig(
     hazkey::config::CurrentConfig currentConfig) {
     hazkey::RequestEnvelope request;
     auto props = request.mutable_set_config();
     *props->mutable_profiles() = currentConfig.profiles();
-    auto response = transact(request);
-    if (response == std::nullopt) {
-        return;
-    }
-    auto responseVal = response.value();
-    if (responseVal.status() != hazkey::SUCCESS) {
-        return;
-    }
+    *props->mutable_file_hashes() = currentConfig.file_hashes();
+    return enqueue([this, request]() {
+        auto response = transact(request);
+        if (response == std::nullopt) {
+            return false;
+        }
+        return response->status() == hazkey::SUCCESS;
+    });
 }
 
-bool ServerConnector::clearAllHistory(const std::string& profileId) {
+QFuture<bool> ServerConnector::clearAllHistory(const std::string& profileId) {
     hazkey::RequestEnvelope request;
     auto clearRequest = request.mutable_clear_all_history();
     clearRequest->set_profile_id(profileId);
-    auto response = transact(request);
-    if (response == std::nullopt) {
-        return false;
-    }
-    auto responseVal = response.value();
-    return responseVal.status() == hazkey::SUCCESS;
+    return enqueue([this, request]() {
+        auto response = transact(request);
+        if (response == std::nullopt) {
+            return false;
+        }
+        return response->status() == hazkey::SUCCESS;
+    });
+}
+
+QFuture<bool> ServerConnector::reloadZenzaiModel() {
+    return enqueue([this]() {
+        hazkey::RequestEnvelope request;
+        auto _ = request.mutable_reload_zenzai_model();
+        auto response = transact(request);
+        if (response == std::nullopt) {
+            return false;
+        }
+        return response->status() == hazkey::SUCCESS;
+    });
 }
 
-bool ServerConnector::reloadZenzaiModel() {
+QFuture<std::optional<hazkey::commands::ServerStats>>
+ServerConnector::getStats() {
+    return enqueue(
+        [this]() -> std::optional<hazkey::commands::ServerStats> {
+            hazkey::RequestEnvelope request;
+            auto _ = request.mutable_get_stats();
+            auto response = transact(request);
+            if (response == std::nullopt) {
+                return std::nullopt;
+            }
+            auto responseVal = response.value();
+            if (responseVal.status() != hazkey::SUCCESS) {
+                return std::nullopt;
+            }
+            if (!responseVal.has_stats()) {
+                return std::nullopt;
+            }
+            return responseVal.stats();
+        });
+}
+
+QFuture<std::optional<hazkey::commands::BenchmarkResult>>
+ServerConnector::runBenchmark(const hazkey::commands::RunBenchmark& benchmark) {
     hazkey::RequestEnvelope request;
-    auto _ = request.mutable_reload_zenzai_model();
-    auto response = transact(request);
-    if (response == std::nullopt) {
-        return false;
-    }
-    auto responseVal = response.value();
-    return responseVal.status() == hazkey::SUCCESS;
+    *request.mutable_run_benchmark() = benchmark;
+    return enqueue(
+        [this, request]() -> std::optional<hazkey::commands::BenchmarkResult> {
+            // slow settings take several seconds per sample on a CPU
+            constexpr int BENCHMARK_TIMEOUT_SEC = 120;
+            auto response = transact(request, BENCHMARK_TIMEOUT_SEC);
+            if (response == std::nullopt) {
+                return std::nullopt;
+            }
+            auto responseVal = response.value();
+            if (responseVal.status() != hazkey::SUCCESS) {
+                return std::nullopt;
+            }
+            if (!responseVal.has_benchmark_result()) {
+                return std::nullopt;
+            }
+            return responseVal.benchmark_result();
+        });
 }
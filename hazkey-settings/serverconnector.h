@@ -1,37 +1,49 @@
 #ifndef SERVERCONNECTOR_H
 #define SERVERCONNECTOR_H
 
+#include <QFuture>
+#include <QThreadPool>
 #include <optional>
 #include <string>
 
 #include "base.pb.h"
 
+// Talks to hazkey-server on a worker thread so that the window never waits
+// for the socket. Requests run one at a time in the order they were made,
+// over a connection that is kept open and re-established when the server
+// drops it (the server serves one client at a time, so fcitx5 typing takes
+// it over). Results are delivered through QFuture; use
+// future.then(context, ...) to handle them on the GUI thread.
 class ServerConnector {
    public:
     ServerConnector();
+    // Waits for queued requests, so that a save made right before closing
+    // still reaches the server.
     ~ServerConnector();
-    std::optional<hazkey::config::CurrentConfig> getConfig();
-    void setCurrentConfig(hazkey::config::CurrentConfig);
-    bool clearAllHistory(const std::string& profileId);
-    bool reloadZenzaiModel();
-
-    // Begin a session with persistent connection
-    bool beginSession();
-    // End the session and close connection
-    void endSession();
-    // Session-aware versions of methods
-    std::optional<hazkey::config::CurrentConfig> getConfigInSession();
-    bool reloadZenzaiModelInSession();
+    QFuture<std::optional<hazkey::config::CurrentConfig>> getConfig();
+    QFuture<bool> setCurrentConfig(hazkey::config::CurrentConfig);
+    QFuture<bool> clearAllHistory(const std::string& profileId);
+    QFuture<bool> reloadZenzaiModel();
+    QFuture<std::optional<hazkey::commands::ServerStats>> getStats();
+    QFuture<std::optional<hazkey::commands::BenchmarkResult>> runBenchmark(
+        const hazkey::commands::RunBenchmark& benchmark);
 
    private:
+    template <typename Job>
+    auto enqueue(Job job) -> QFuture<decltype(job())>;
+
+    // The members below are only used on the worker thread.
     std::string getSocketPath();
     int createConnection();
+    bool connectionAlive();
+    void closeConnection();
     std::optional<hazkey::ResponseEnvelope> transact(
-        const hazkey::RequestEnvelope& send_data);
+        const hazkey::RequestEnvelope& send_data, int timeoutSec = 10);
     std::optional<hazkey::ResponseEnvelope> transactOnSocket(
-        int sock, const hazkey::RequestEnvelope& send_data);
+        int sock, const hazkey::RequestEnvelope& send_data, int timeoutSec);
 
-    int session_socket_;
+    int socket_;
+    QThreadPool worker_;
 };
 
 #endif  // SERVERCONNECTOR_H
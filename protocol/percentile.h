@@ -0,0 +1,20 @@
+#ifndef _HAZKEY_PROTOCOL_PERCENTILE_H_
+#define _HAZKEY_PROTOCOL_PERCENTILE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Nearest-rank percentile, p in [0, 1]; 0 for no values. Kept here with the
+// protocol because the addon's tools and hazkey-settings both include it.
+inline double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t index = std::ceil(p * values.size());
+    return values[std::clamp<size_t>(index, 1, values.size()) - 1];
+}
+
+#endif  // _HAZKEY_PROTOCOL_PERCENTILE_H_